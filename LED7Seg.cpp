@@ -11,12 +11,113 @@
 /// limitations under the License.
 ///
 #include "LED7Seg.h"
+#if defined(__AVR__)
+#include <avr/sleep.h>
+#endif
+
+#if LED_PORT_IO
+/// Digit gate images letting every digit through and none
+static const uint8_t s_gateOn[LED_MAX_PORTS] = { 0xFF, 0xFF, 0xFF };
+static const uint8_t s_gateOff[LED_MAX_PORTS] = { 0x00, 0x00, 0x00 };
+#endif
 
 /// Constructor
-SevSeg::SevSeg()
+SevSegBase::SevSegBase()
 {
     m_index = 0;
     m_digits = 0;
+    m_timerMode = SCAN_NONE;
+    m_newFrame = false;
+    m_front = 0;
+    m_flip = 0;
+    m_stale = 0;
+    m_autoCommit = true;
+    m_skip = false;
+    m_scanMode = SCAN_SEGMENTS;
+    m_tick = 0;
+    m_commit = 0;
+    m_update = 0;
+#if LED_POWER
+    m_power = POWER_ON;
+    m_active = false;
+    m_powerDue = false;
+    m_lowAfter = 0;
+    m_blankAfter = 0;
+#endif
+    m_buf = m_page[1].buf;
+    for (uint8_t p = 0; p < 2; ++p)
+    {
+        for (uint8_t d = 0; d < MAX_DIGITS; ++d)
+        {
+            m_page[p].buf[d] = SEG_NONE;
+        }
+        for (uint8_t s = 0; s < SEGMENTS; ++s)
+        {
+            m_page[p].planes[s] = DIG_NONE;
+        }
+        m_page[p].digits = DIG_NONE;
+        m_page[p].segments = 0;
+        m_page[p].scanMode = SCAN_SEGMENTS;
+    }
+#if LED_BRIGHT
+    for (uint8_t b = 0; b < LED_BRIGHT_BITS; ++b)
+    {
+        m_bright[b] = LED_DIG_ALL;
+    }
+    m_bcmBit = 0;
+    m_dimmed = false;
+#endif
+#if LED_PLAYER
+    m_playMode = MARQUEE_OFF;
+    m_playDue = false;
+    m_anDone = 0;
+    m_anEnded = false;
+#endif
+#if LED_STATS
+    m_stats.nominal = 1000;
+    resetStats();
+#endif
+    m_dirty = DIG_NONE;
+    m_changed = false;
+    m_gate = LED_DIG_ALL;
+#if LED_BLINK
+    m_blink = DIG_NONE;
+    m_blinkOff = DIG_NONE;
+    m_blinkStep = 500;
+    m_blinkLast = 0;
+    for (uint8_t d = 0; d < MAX_DIGITS; ++d)
+    {
+        m_alt[d] = SEG_NONE;
+    }
+    updateBlink(DIG_NONE);
+#endif
+}
+
+/// Constructor
+SevSeg::SevSeg()
+{
+    m_pins = 0;
+    m_out = 0;
+    m_segShadow = SEG_NONE;
+    m_digShadow = DIG_NONE;
+#if LED_PORT_IO
+    m_ports = 0;
+    m_images[0].mode = SCAN_NONE;
+    m_images[1].mode = SCAN_NONE;
+#endif
+#if LED_KEYS
+    m_keyReturns = 0;
+    m_keyLines = DIG_NONE;
+    m_keyLine = 0;
+    m_keyPhase = KEY_IDLE;
+    for (uint8_t r = 0; r < LED_KEY_RETURNS; ++r)
+    {
+        m_keyRaw[r] = 0;
+        m_keyDown[r] = 0;
+    }
+    m_keyHead = 0;
+    m_keyTail = 0;
+#endif
 }
 
 /// Initialization function
@@ -28,7 +129,10 @@ void SevSeg::begin(enum led_config conf, uint8_t digits, const uint8_t* pins)
     m_config = conf;
     m_digits = digits;
     m_pins = pins;
-    
+    m_out = 0;
+    // Unknown pin levels: the first setDigits()/setSegments() writes all
+    m_segShadow = (enum led_seg) 0xFF;
+    m_digShadow = LED_DIG_ALL;
 
     // Set all pins as outputs
     for (uint8_t i=0 ; i < SEGMENTS + digits; ++i)
@@ -36,6 +140,9 @@ void SevSeg::begin(enum led_config conf, uint8_t digits, const uint8_t* pins)
         int pin = m_pins[i];
         pinMode(pin, OUTPUT);
     }
+#if LED_PORT_IO
+    mapPins();
+#endif
 
     // Turn all digits off
     setDigits(DIG_NONE);
@@ -45,19 +152,65 @@ void SevSeg::begin(enum led_config conf, uint8_t digits, const uint8_t* pins)
     m_last = millis();
 }
 
+///
+/// Initialization function for an output backend (shift register or LED
+/// controller, see LEDDrivers.h)
+/// @param  out         Output backend
+/// @param  digits      Number of digits
+///
+void SevSeg::begin(LEDOutput* out, uint8_t digits)
+{
+    m_config = 0;
+    m_digits = digits;
+    m_pins = 0;
+    m_out = out;
+#if LED_PORT_IO
+    m_ports = 0;
+#endif
+    out->begin(digits);
+    m_segShadow = SEG_NONE;
+    m_digShadow = DIG_NONE;
+    out->slot(SEG_NONE, DIG_NONE);
+    out->frame(m_page[m_front].buf, digits);
+    m_last = millis();
+}
+
 ///
 /// Set all LED segment pins based on mask
 /// @param  mask    Bit mask (SEG_A,SEG_B,SEG_C,SEG_D,SEG_E,SEG_F,SEG_G,SEG_DP)
 ///
 void SevSeg::setSegments(enum led_seg mask)
 {
+#if LED_PORT_IO
+    if (m_ports)
+    {
+        uint8_t image[LED_MAX_PORTS];
+        buildImage(image, mask, DIG_NONE);
+        writePorts(image, m_segPort);
+        return;
+    }
+#endif
+    // Only pins that changed since the last call are written
+    uint8_t changed = mask ^ m_segShadow;
+    if (changed == 0)
+        return;
+    m_segShadow = mask;
+    if (m_out)
+    {
+        m_out->slot(m_segShadow, m_digShadow);
+        return;
+    }
     if (m_config & SEG_INVERT)
         mask = (enum led_seg)(~mask);
     for (uint8_t i = 0; i < SEGMENTS; ++i)
     {
-        boolean pinState = (mask & 0x01);
-        int pin = m_pins[i];
-        digitalWrite(pin, pinState);
+        if (changed & 0x01)
+        {
+            boolean pinState = (mask & 0x01);
+            int pin = m_pins[i];
+            digitalWrite(pin, pinState);
+        }
+        changed >>= 1;
         mask = (enum led_seg) (mask >> 1);
     }
 }
@@ -68,17 +221,49 @@ void SevSeg::setSegments(enum led_seg mask)
 ///
 void SevSeg::setDigits(enum led_dig mask)
 {
+#if LED_PORT_IO
+    if (m_ports)
+    {
+        uint8_t image[LED_MAX_PORTS];
+        buildImage(image, SEG_NONE, mask);
+        writePorts(image, m_digPort);
+        return;
+    }
+#endif
+    // Only pins that changed since the last call are written
+    led_digmask changed = mask ^ m_digShadow;
+    if (changed == 0)
+        return;
+    m_digShadow = mask;
+    if (m_out)
+    {
+        m_out->slot(m_segShadow, m_digShadow);
+        return;
+    }
     if (m_config & DIG_INVERT)
         mask = (enum led_dig)(~mask);
     for (uint8_t i = 0; i < m_digits; ++i)
     {
-        boolean pinState = (mask & 0x01);
-        int pin = m_pins[i + SEGMENTS];
-        digitalWrite(pin, pinState);
+        if (changed & 0x01)
+        {
+            boolean pinState = (mask & 0x01);
+            int pin = m_pins[i + SEGMENTS];
+            digitalWrite(pin, pinState);
+        }
+        changed >>= 1;
         mask = (enum led_dig)(mask >> 1);
     }
 }
 
+///
+/// Turn every digit off through the output path of the display.  Derived
+/// displays that drive the pins themselves override this.
+///
+void SevSeg::blank(void)
+{
+    setDigits(DIG_NONE);
+}
+
 ///
 /// Refresh/multiplex all the digits on the LED Display.  Use this method
 /// when the current limiting resistors are in series with the segment pins.
@@ -86,20 +271,31 @@ void SevSeg::setDigits(enum led_dig mask)
 void SevSeg::refreshDigits()
 {
     unsigned long now = millis();
-    if (now != m_last)
+    if (m_timerMode != SCAN_NONE)
+    {
+        update();
+    }
+    else if (now != m_last)
     {
+#if LED_STATS
+        const unsigned long start = statBegin();
+#endif
         m_last = now;
-        // Turn off all digits
-        setDigits(DIG_NONE);
-        // Increment m_index modulo m_digits
-        uint8_t index = m_index + 1;
-        if (index >= m_digits)
-            index = 0;
-        m_index = index;
-        // Set segments for digit
-        setSegments(m_buf[index]);
-        // Turn on one digit at a time
-        setDigits((enum led_dig)(DIG_0 << index));
+#if LED_PLAYER
+        tickPlayer(now);
+#endif
+#if LED_BLINK
+        tickBlink(now);
+#endif
+#if LED_KEYS
+        tickKeys(now);
+        if (m_keyPhase == KEY_IDLE || !keySlot())
+#endif
+            scanDigits();
+#if LED_STATS
+        statEnd(start);
+#endif
+        update();
     }
 }
 
@@ -110,133 +306,2061 @@ void SevSeg::refreshDigits()
 void SevSeg::refreshSegments()
 {
     unsigned long now = millis();
-    if (now != m_last)
+    if (m_timerMode != SCAN_NONE)
+    {
+        update();
+    }
+    else if (now != m_last)
     {
-        enum led_dig digitMask = DIG_NONE;
-        enum led_seg segMask;
-        
+#if LED_STATS
+        const unsigned long start = statBegin();
+#endif
         m_last = now;
-        // Turn off all digits
-        setDigits(DIG_NONE);
-        // Increment m_index modulo m_digits
-        uint8_t index = m_index + 1;
-        if (index >= SEGMENTS)
-            index = 0;
-        m_index = index;
-        // Turn on one segment at a time
-        segMask = (enum led_seg)(SEG_A << index);
-        setSegments(segMask);
-        // Determines digits containing segment
-        for (uint8_t dig = 0; dig < MAX_DIGITS; ++dig)
-        {
-            if (m_buf[dig] & segMask)
+#if LED_PLAYER
+        tickPlayer(now);
+#endif
+#if LED_BLINK
+        tickBlink(now);
+#endif
+#if LED_KEYS
+        tickKeys(now);
+        if (m_keyPhase == KEY_IDLE || !keySlot())
+#endif
+            scanSegments();
+#if LED_STATS
+        statEnd(start);
+#endif
+        update();
+    }
+}
+
+///
+/// Advance the display to the next digit.  Called by refreshDigits()
+/// or from a timer interrupt.
+///
+void SevSeg::scanDigits()
+{
+    slotDigits(nextSlot(SCAN_DIGITS));
+}
+
+///
+/// Show the digit slot m_index of a page
+/// @param  page    Page to display
+///
+void SevSeg::slotDigits(struct led_page* page)
+{
+    uint8_t index = m_index;
+#if LED_BLINK
+    // Blinking digits show their alternate content in the off phase
+    const boolean alt = (m_blinkOff & (DIG_0 << index)) != 0;
+    const enum led_seg seg = alt ? m_alt[index] : page->buf[index];
+#else
+    const enum led_seg seg = page->buf[index];
+#endif
+    if (m_out)
+    {
+        // One transfer per slot
+        m_segShadow = seg;
+        m_digShadow = (enum led_dig)((DIG_0 << index) & m_gate);
+        m_out->slot(m_segShadow, m_digShadow);
+        return;
+    }
+#if LED_PORT_IO
+    if (m_ports)
+    {
+        struct led_images* images = imagesOf(page);
+        if (images->mode != SCAN_DIGITS)
+            renderImages(page, SCAN_DIGITS);
+#if LED_BLINK
+        outputImage(alt ? m_altImage[index] : images->image[index]);
+#else
+        outputImage(images->image[index]);
+#endif
+        return;
+    }
+#endif
+    const enum led_dig dig = (enum led_dig)((DIG_0 << index) & m_gate);
+    // Turn off the digits not lit in this slot
+    setDigits((enum led_dig)(m_digShadow & dig));
+    // Set segments for digit
+    setSegments(seg);
+    // Turn on one digit at a time
+    setDigits(dig);
+}
+
+///
+/// Advance the display to the next segment.  Called by refreshSegments()
+/// or from a timer interrupt.
+///
+void SevSeg::scanSegments()
+{
+    slotSegments(nextSlot(SCAN_SEGMENTS));
+}
+
+///
+/// Show the segment slot m_index of a page
+/// @param  page    Page to display
+///
+void SevSeg::slotSegments(struct led_page* page)
+{
+    uint8_t index = m_index;
+#if LED_BLINK
+    // Blinking digits show their alternate content in the off phase
+    const led_digmask off = m_blinkOff;
+    const enum led_dig plane = (enum led_dig)((page->planes[index] & ~off) | (m_altPlanes[index] & off));
+#else
+    const enum led_dig plane = page->planes[index];
+#endif
+    if (m_out)
+    {
+        // One transfer per slot
+        m_segShadow = (enum led_seg)(SEG_A << index);
+        m_digShadow = (enum led_dig)(plane & m_gate);
+        m_out->slot(m_segShadow, m_digShadow);
+        return;
+    }
+#if LED_PORT_IO
+    if (m_ports)
+    {
+        struct led_images* images = imagesOf(page);
+        if (images->mode != SCAN_SEGMENTS)
+            renderImages(page, SCAN_SEGMENTS);
+#if LED_BLINK
+        if (off)
+        {
+            // Replace the levels of the blinking digit pins
+            uint8_t image[LED_MAX_PORTS];
+            for (uint8_t p = 0; p < m_ports; ++p)
             {
-                digitMask =  (enum led_dig)(digitMask | (DIG_0 << dig));
+                image[p] = (uint8_t)((images->image[index][p] & ~m_blinkX[p]) | m_altX[index][p]);
             }
+            outputImage(image);
+            return;
         }
-        // Set segment for digit(s)
-        setDigits(digitMask);
+#endif
+        outputImage(images->image[index]);
+        return;
     }
+#endif
+    const enum led_dig dig = (enum led_dig)(plane & m_gate);
+    // Turn off the digits not lit in this slot
+    setDigits((enum led_dig)(m_digShadow & dig));
+    // Turn on one segment at a time
+    enum led_seg segMask = (enum led_seg)(SEG_A << index);
+    setSegments(segMask);
+    // Set segment for digit(s)
+    setDigits(dig);
+}
+
+///
+/// Advance the display to the next non-empty slot, scanning each frame by
+/// digits or by segments, whichever has fewer non-empty slots.  Needs
+/// current limiting on both the segment and the digit lines (see SevSeg).
+/// Called from the timer interrupt with attachTimer(SCAN_AUTO, hz).
+///
+void SevSeg::scanAuto()
+{
+    struct led_page* page = nextSlot(SCAN_AUTO);
+    if (m_scanMode == SCAN_DIGITS)
+        slotDigits(page);
+    else
+        slotSegments(page);
 }
 
-enum led_seg getHexDigit(int num, uint8_t shift)
+///
+/// Only visit the slots that light something: blank digits when scanning
+/// digits, unused segments (e.g. DP) when scanning segments.  Frames get
+/// shorter, so lit digits are brighter at the same scan rate, but the
+/// brightness then depends on the number of non-empty slots.
+/// @param  on      true to skip empty slots
+///
+void SevSegBase::setSkipEmpty(boolean on)
 {
-    enum led_seg mask = (enum led_seg)pgm_read_byte_near(LED_HexFont + ((num >> shift) & 15));
-    return mask;
+    m_skip = on;
 }
 
 ///
-/// Show number as hexadecimal right justified on the LED display
-/// @param num     Number to display
+/// Update the segment-major bitplanes of a page for the dirty digits:
+/// planes[s] has bit d set when digit d shows segment s (bit matrix
+/// transpose of buf).
+/// @param  page    Display page
+/// @return planes  Bit mask of the planes that changed (bit s = planes[s])
 ///
-void SevSeg::showHex(unsigned long num)
+uint8_t SevSegBase::buildPlanes(struct led_page* page)
 {
-    char str[MAX_DIGITS+1];
-    str[MAX_DIGITS] = '\0';
+    uint8_t changed = 0;
+    led_digmask digitBit = DIG_0;
     for (uint8_t d = 0; d < m_digits; ++d)
     {
-        m_buf[m_digits - 1 - d] = getHexDigit(num, 4 * d);
+        if (m_dirty & digitBit)
+        {
+            uint8_t seg = page->buf[d];
+            for (uint8_t s = 0; s < SEGMENTS; ++s)
+            {
+                const led_digmask plane = page->planes[s];
+                const led_digmask next = (seg & 0x01) ? (led_digmask)(plane | digitBit) : (led_digmask)(plane & ~digitBit);
+                if (next != plane)
+                {
+                    page->planes[s] = (enum led_dig) next;
+                    changed |= (uint8_t)(1 << s);
+                }
+                seg >>= 1;
+            }
+        }
+        digitBit <<= 1;
     }
+    return changed;
 }
 
 ///
-/// Show number as unsigned decimal with [optional] decimal point
-/// right justified on the LED display.
-/// @param num     Number to display
-/// @param dp      Number of decimal places (-1 if no decimal point)
-/// @param fill    Fill char (' ', '-' or '+')
+/// Record the non-empty digit and segment slots of a page and the scan
+/// mode with fewer of them (segments on a tie: less current per pin).
+/// @param  page    Page to update
+///
+void SevSegBase::activeSlots(struct led_page* page)
+{
+    led_digmask digits = 0;
+    uint8_t segments = 0;
+    uint8_t segCount = 0;
+    uint8_t bit = 0x01;
+    for (uint8_t s = 0; s < SEGMENTS; ++s)
+    {
+        const led_digmask plane = page->planes[s];
+        if (plane)
+        {
+            digits |= plane;
+            segments |= bit;
+            ++segCount;
+        }
+        bit <<= 1;
+    }
+    uint8_t digCount = 0;
+    for (led_digmask d = digits; d; d >>= 1)
+    {
+        digCount += d & 0x01;
+    }
+    page->digits = (enum led_dig) digits;
+    page->segments = segments;
+    page->scanMode = (digCount < segCount) ? SCAN_DIGITS : SCAN_SEGMENTS;
+}
+
+///
+/// Prepare the back page for drawing.  Waits for a pending page flip
+/// (at most one frame) so the page being drawn is never on display.
 ///
-void SevSeg::showNumber(unsigned long num, uint8_t dp, enum led_seg fill/*=SEG_NONE*/)
+void SevSegBase::beginUpdate(void)
 {
-    char str[MAX_DIGITS + 1];
-    str[MAX_DIGITS] = '\0';
-    uint8_t d = 0;
-    while (d < m_digits)
+#if LED_PLAYER
+    // Drawing replaces a running marquee or animation.  A step it drew
+    // but did not commit yet is dropped.
+    m_playMode = MARQUEE_OFF;
+    if (m_playDue)
+    {
+        m_playDue = false;
+        m_stale = true;
+    }
+#endif
+    while (m_flip)
     {
-        uint8_t mask = pgm_read_byte_near(LED_HexFont + (num % 10));
-        uint8_t index = m_digits - d - 1;
-        m_buf[index] = (enum led_seg)((d == dp) ? (mask | SEG_DP) : mask);
-        ++d;
-        num = num / 10;
-        if (num == 0 && d > dp)
+#if !defined(ARDUINO)
+        LED_HostYield();
+#endif
+    }
+    uint8_t back = m_front ^ 1;
+    m_buf = m_page[back].buf;
+    if (m_stale)
+    {
+        // Start from the committed contents.  Digits that differ need
+        // their planes and images rebuilt.
+        const enum led_seg* front = m_page[m_front].buf;
+        for (uint8_t d = 0; d < MAX_DIGITS; ++d)
         {
-            // Fill leading 0s
-            while (d < m_digits)
+            if (m_buf[d] != front[d])
             {
-                uint8_t index = m_digits - d - 1;
-                m_buf[index] = (enum led_seg)((d == dp) ? (fill | SEG_DP) : fill);
-                ++d;
-                // Insure only one '-' sign
-                if (fill != LED_0)
-                {
-                    fill = LED_BLANK;
-                }
+                m_buf[d] = front[d];
+                m_dirty = (enum led_dig)(m_dirty | (DIG_0 << d));
             }
         }
+        m_stale = false;
+        m_changed = false;
     }
 }
 
 ///
-/// Show number as signed decimal with [optional] decimal point
-/// right justified on the LED display.
-/// @param num     Number to display
-/// @param dp      Decimal Places (-1 if no decimal point)
+/// Build the planes and slots of the back page for a commit
+/// @param  page    Back page
+/// @return planes  Bit mask of the planes that changed (from buildPlanes())
 ///
-void SevSeg::showDecimal(signed long num, uint8_t dp)
+uint8_t SevSegBase::buildPage(struct led_page* page)
 {
-    if (num < 0)
+    const uint8_t planes = buildPlanes(page);
+    activeSlots(page);
+    return planes;
+}
+
+///
+/// Finish a commit once the output state of the back page is updated:
+/// swap the pages, at the next frame boundary when refreshed by the timer
+///
+void SevSegBase::flipPage(void)
+{
+    m_dirty = DIG_NONE;
+    m_changed = false;
+    m_stale = true;
+    if (m_timerMode != SCAN_NONE)
     {
-        showNumber(-num, dp, LED_MINUS);
+        m_flip = true;
     }
     else
     {
-        showNumber(num, dp, LED_BLANK);
+        m_front ^= 1;
     }
+#if LED_POWER
+    // New content restarts the power save timeout.  The caller restores
+    // the timer rate with applyPower().
+    m_active = true;
+    if (m_power != POWER_ON)
+    {
+        m_power = POWER_ON;
+        m_powerDue = true;
+    }
+#endif
 }
 
 ///
-/// Show text string as ASCII characters with [optional] decimal
-/// point left justified on the LED display.
-/// @param str     Text string to display
+/// Update the port images of a committed page and send it to a controller
+/// backend.  The page gets the images of the mode the timer will scan it
+/// in, which keeps image rendering out of the timer interrupt.
+/// @param  page    Committed page
+/// @param  planes  Bit mask of the changed planes (from buildPlanes())
 ///
-void SevSeg::showText(const char* str)
+void SevSeg::updatePage(struct led_page* page, uint8_t planes)
 {
-    for (uint8_t d = 0; d < m_digits; ++d)
+#if LED_PORT_IO
+    if (m_ports)
     {
-		const uint8_t c = str[d] - ' ';
-        m_buf[d] = LED_GET_FONT(LED_AsciiFont, c);
+        const uint8_t imageMode = imagesOf(page)->mode;
+        const uint8_t mode = (m_timerMode == SCAN_AUTO) ? page->scanMode : m_timerMode;
+        if (mode != SCAN_NONE && imageMode != mode)
+            renderImages(page, (enum led_scan) mode);
+        else if (imageMode != SCAN_NONE)
+            updateImages(page, planes);
     }
+#else
+    (void) planes;
+#endif
+    if (m_out)
+        m_out->frame(page->buf, m_digits);
 }
 
 ///
-/// Show raw segments (A-F + decimal point) left justified on the LED display.
-/// Useful for displaying graphics and other special symbols.
-/// @param buf     Buffer of segment masks
+/// Select whether show*() methods commit immediately (default) or only
+/// draw into the back page until commit() is called.
+/// @param  on      true to commit after every show*() call
 ///
-void SevSeg::showRaw(const enum led_seg* buf)
+void SevSegBase::setAutoCommit(boolean on)
 {
-    for (uint8_t b = 0; b < m_digits; ++b)
+    m_autoCommit = on;
+}
+
+SevSegBase* SevSegBase::s_timer[LED_MAX_DISPLAYS];
+uint8_t SevSegBase::s_timers = 0;
+uint8_t SevSegBase::s_phase = 0;
+uint8_t SevSegBase::s_phases = 1;
+uint16_t SevSegBase::s_hz = 0;
+#if LED_POWER
+uint16_t SevSegBase::s_lowHz = 250;
+uint8_t SevSegBase::s_power = POWER_ON;
+#endif
+
+#if defined(__AVR__) && (LED_TIMER == 1)
+ISR(TIMER1_COMPA_vect)
+{
+    SevSegBase::timerTick();
+}
+#elif defined(__AVR__) && (LED_TIMER == 2)
+ISR(TIMER2_COMPA_vect)
+{
+    SevSegBase::timerTick();
+}
+#endif
+
+#if LED_BRIGHT
+/// Index of the full slot in s_ocr (after the brightness bits)
+#define LED_OCR_SLOT        LED_BRIGHT_BITS
+#else
+#define LED_OCR_SLOT        0
+#endif
+
+/// Timer compare values: 2^bit brightness units, then a full slot
+static uint16_t s_ocr[LED_OCR_SLOT + 1];
+
+///
+/// Compute the compare values for a timer clock
+/// @param  clock   Timer clock in Hz (after prescaler)
+/// @param  hz      Tick rate in Hz
+/// @param  limit   Largest timer count
+/// @return true    if a full slot fits the timer
+///
+static boolean timerCounts(unsigned long clock, unsigned long hz, unsigned long limit)
+{
+    const unsigned long slot = clock / hz;
+    if (slot == 0 || slot > limit)
+        return false;
+#if LED_BRIGHT
+    // A full slot is about LED_BRIGHT_MAX brightness units
+    unsigned long unit = slot / LED_BRIGHT_MAX;
+    const unsigned long minUnit = (clock / 1000UL) * LED_BRIGHT_MIN_US / 1000UL;
+    if (unit < minUnit)
+        unit = minUnit;
+    if (unit == 0 || (unit << (LED_BRIGHT_BITS - 1)) > limit)
+        return false;
+    for (uint8_t b = 0; b < LED_BRIGHT_BITS; ++b)
+    {
+        s_ocr[b] = (uint16_t)((unit << b) - 1);
+    }
+#endif
+    s_ocr[LED_OCR_SLOT] = (uint16_t)(slot - 1);
+    return true;
+}
+
+///
+/// Set the length of the next timer period
+/// @param  i       Index into s_ocr (brightness bit or LED_OCR_SLOT)
+///
+static inline void timerPeriod(uint8_t i)
+{
+#if defined(__AVR__) && (LED_TIMER == 1)
+    OCR1A = s_ocr[i];
+#elif defined(__AVR__) && (LED_TIMER == 2)
+    OCR2A = (uint8_t) s_ocr[i];
+#elif !defined(ARDUINO)
+    LED_HostTimerPeriod(s_ocr[i] + 1UL);
+#else
+    (void) i;
+#endif
+}
+
+///
+/// Start (or stop) the refresh timer
+/// @param  hz      Tick rate in Hz (0 = stop)
+/// @return true    if the timer was started
+///
+static boolean timerStart(unsigned long hz)
+{
+#if defined(__AVR__) && (LED_TIMER == 1)
+    TIMSK1 &= ~_BV(OCIE1A);
+    TCCR1A = 0;
+    TCCR1B = 0;
+    if (hz == 0)
+        return false;
+    // CTC mode, prescaler 8 (or 64 for slow rates)
+    uint8_t cs = _BV(CS11);
+    if (!timerCounts(F_CPU / 8, hz, 65536UL))
+    {
+        cs = _BV(CS11) | _BV(CS10);
+        if (!timerCounts(F_CPU / 64, hz, 65536UL))
+            return false;
+    }
+    TCNT1 = 0;
+    OCR1A = s_ocr[LED_OCR_SLOT];
+    TCCR1B = _BV(WGM12) | cs;
+    TIMSK1 |= _BV(OCIE1A);
+    return true;
+#elif defined(__AVR__) && (LED_TIMER == 2)
+    // Prescaler shift for CS2=1..7 (1, 8, 32, 64, 128, 256, 1024)
+    static const uint8_t shifts[7] = { 0, 3, 5, 6, 7, 8, 10 };
+    TIMSK2 &= ~_BV(OCIE2A);
+    TCCR2A = 0;
+    TCCR2B = 0;
+    if (hz == 0)
+        return false;
+    for (uint8_t cs = 0; cs < 7; ++cs)
+    {
+        if (timerCounts(F_CPU >> shifts[cs], hz, 256))
+        {
+            TCNT2 = 0;
+            OCR2A = (uint8_t) s_ocr[LED_OCR_SLOT];
+            TCCR2A = _BV(WGM21);
+            TCCR2B = cs + 1;
+            TIMSK2 |= _BV(OCIE2A);
+            return true;
+        }
+    }
+    return false;
+#elif !defined(ARDUINO)
+    // Simulated timer counts microseconds
+    if (hz == 0 || !timerCounts(1000000UL, hz, 0xFFFFUL))
+    {
+        LED_HostTimerStart(0, 0);
+        return false;
+    }
+    LED_HostTimerStart(s_ocr[LED_OCR_SLOT] + 1UL, SevSegBase::timerTick);
+    return true;
+#else
+    (void) hz;
+    return false;
+#endif
+}
+
+///
+/// Refresh the display from a hardware timer interrupt instead of polling
+/// refreshDigits()/refreshSegments() from loop().  The timer is selected at
+/// build time with LED_TIMER (1=Timer1, 2=Timer2).  While attached, the
+/// refresh methods only call update(), so sketches may keep calling them.
+/// Otherwise call update() or idle() from loop(): the interrupt draws
+/// marquee and animation steps, but they are committed by update().
+///
+/// Up to LED_MAX_DISPLAYS displays can be attached; they share the one
+/// timer.  At most LED_TICK_SLOTS displays are serviced per tick: the
+/// others take turns on the following ticks and the tick rate is raised
+/// so each display still gets hz slots of equal length per second.  All
+/// attached displays use the rate of the last call.  Brightness
+/// modulation is only available with a single display attached.
+/// @param  mode    SCAN_DIGITS, SCAN_SEGMENTS or SCAN_AUTO (see scanAuto())
+/// @param  hz      Scan rate in slots per second (e.g. 1000)
+/// @return true    if the timer is running
+///
+boolean SevSeg::attachTimer(enum led_scan mode, uint16_t hz)
+{
+    if (mode == SCAN_AUTO)
+        return startTimer(mode, hz, tickAuto);
+    return startTimer(mode, hz, (mode == SCAN_DIGITS) ? tickDigits : tickSegments);
+}
+
+///
+/// Add the display to the timer refresh (see SevSegCore::startTimer()).
+/// The display is detached and its page rendered for the scan mode.
+/// @param  mode    SCAN_DIGITS, SCAN_SEGMENTS or SCAN_AUTO
+/// @param  hz      Scan rate in slots per second
+/// @param  tick    Handler called from the timer interrupt
+/// @return true    if the timer is running
+///
+boolean SevSegBase::addTimer(enum led_scan mode, uint16_t hz, void (*tick)(SevSegBase* led))
+{
+    m_timerMode = mode;
+    m_tick = tick;
+    m_newFrame = false;
+    m_scanMode = m_page[m_front].scanMode;
+    // Stop the timer while the display list changes
+    const uint16_t oldHz = s_hz;
+    timerStart(0);
+    s_timer[s_timers++] = this;
+    if (!restartTimer(hz))
+    {
+        --s_timers;
+        m_timerMode = SCAN_NONE;
+        restartTimer(oldHz);
+#if LED_STATS
+        m_stats.nominal = 1000;
+#endif
+        return false;
+    }
+    // Brightness is only modulated with a single display attached
+    for (uint8_t i = 0; i < s_timers; ++i)
+    {
+        s_timer[i]->updateGate();
+    }
+    return true;
+}
+
+///
+/// Restart the timer for the attached displays, interleaving them over
+/// ceil(s_timers / LED_TICK_SLOTS) ticks.
+/// @param  hz      Slot rate of each display in Hz
+/// @return true    if the timer is running
+///
+boolean SevSegBase::restartTimer(uint16_t hz)
+{
+    s_hz = hz;
+    s_phase = 0;
+#if LED_POWER
+    s_power = POWER_ON;
+    for (uint8_t i = 0; i < s_timers; ++i)
+    {
+        s_timer[i]->m_power = POWER_ON;
+        s_timer[i]->m_active = true;
+    }
+#endif
+    s_phases = (uint8_t)((s_timers + LED_TICK_SLOTS - 1) / LED_TICK_SLOTS);
+    if (s_phases == 0)
+        s_phases = 1;
+#if LED_STATS
+    for (uint8_t i = 0; i < s_timers; ++i)
     {
-        m_buf[b] = buf[b];
+        s_timer[i]->m_stats.nominal = hz ? 1000000UL / hz : 1000;
+        s_timer[i]->resetStats();
     }
+#endif
+    return s_timers && timerStart((unsigned long) hz * s_phases);
+}
+
+///
+/// Remove the display from the timer refresh (see
+/// SevSegCore::detachTimer(), which turns its digits off)
+/// @return true    if it was refreshed by the timer
+///
+boolean SevSegBase::removeTimer(void)
+{
+    boolean found = false;
+    for (uint8_t i = 0; i < s_timers && !found; ++i)
+    {
+        if (s_timer[i] == this)
+        {
+            timerStart(0);
+            for (uint8_t j = i + 1; j < s_timers; ++j)
+            {
+                s_timer[j - 1] = s_timer[j];
+            }
+            --s_timers;
+#if LED_POWER
+            m_power = POWER_ON;
+#endif
+            if (m_flip)
+            {
+                m_front ^= 1;
+                m_flip = 0;
+            }
+            restartTimer(s_hz);
+            // The remaining display may be dimmed again
+            for (uint8_t j = 0; j < s_timers; ++j)
+            {
+                s_timer[j]->updateGate();
+            }
+            found = true;
+        }
+    }
+    m_timerMode = SCAN_NONE;
+    updateGate();
+#if LED_STATS
+    // Polled refresh shows one slot per millisecond
+    m_stats.nominal = 1000;
+    resetStats();
+#endif
+    return found;
+}
+
+///
+/// Timer interrupt handler: advance each display due on this tick by one
+/// slot.  Tick s_phase services displays s_phase, s_phase + s_phases, ..
+///
+void SevSegBase::timerTick(void)
+{
+    const uint8_t phase = s_phase;
+#if LED_BRIGHT
+    // Set the length of this slot first.  OCR1A is not double-buffered in
+    // CTC mode: a compare value written after the counter has passed it
+    // only matches once the counter wraps around.
+    if (s_timers)
+    {
+        // Slot lasts 2^bit units while dimming (single display), else a full slot
+        SevSegBase* led = s_timer[0];
+        timerPeriod(!led->m_dimmed ? LED_OCR_SLOT : led->slotBit());
+    }
+#endif
+    for (uint8_t i = phase; i < s_timers; i += s_phases)
+    {
+        SevSegBase* led = s_timer[i];
+#if LED_POWER
+        if (led->m_power == POWER_BLANK)
+            continue;
+#endif
+#if LED_STATS
+        const unsigned long start = led->statBegin();
+#endif
+        led->m_tick(led);
+#if LED_PLAYER || LED_BLINK || LED_POWER
+        // Once per frame (nextSlot() wrapped around)
+        if (led->m_newFrame)
+        {
+            const unsigned long now = millis();
+            led->m_newFrame = false;
+#if LED_PLAYER
+            led->tickPlayer(now);
+#endif
+#if LED_BLINK
+            led->tickBlink(now);
+#endif
+#if LED_POWER
+            if (led->m_lowAfter | led->m_blankAfter)
+                led->tickPower(now);
+#endif
+        }
+#endif
+#if LED_STATS
+        led->statEnd(start);
+#endif
+    }
+    s_phase = (uint8_t)((phase + 1 < s_phases) ? phase + 1 : 0);
+}
+
+#if LED_POWER
+///
+/// Save power while the content does not change (timer refresh only).
+/// After lowSec seconds without a commit the timer drops to lowHz slots
+/// per second (once every attached display is idle); after blankSec
+/// seconds the display is turned off and, once all displays are off, the
+/// timer is stopped.  The next commit (any show*() call) restores the
+/// display and scan rate at once.  The interrupt only records the state
+/// change; the rate changes in idle(), update() or the next commit, so
+/// use with idle() (or update()) in loop().
+/// @param  lowSec      Seconds before the low scan rate (0 = never)
+/// @param  blankSec    Seconds before blanking (0 = never)
+/// @param  lowHz       Low scan rate in slots per second (shared timer)
+///
+void SevSegBase::setPowerSave(uint16_t lowSec, uint16_t blankSec, uint16_t lowHz/*=250*/)
+{
+#if defined(__AVR__)
+    uint8_t oldSREG = SREG;
+    cli();
+#endif
+    m_lowAfter = lowSec;
+    m_blankAfter = blankSec;
+    s_lowHz = lowHz;
+    m_active = true;
+    if (m_power != POWER_ON)
+        wake();
+#if defined(__AVR__)
+    SREG = oldSREG;
+#endif
+}
+
+///
+/// Get the power save state
+/// @return state   POWER_ON, POWER_LOW or POWER_BLANK
+///
+enum led_power SevSegBase::powerState(void)
+{
+    return (enum led_power) m_power;
+}
+#endif
+
+///
+/// Sleep until the next interrupt.  The refresh timer (and the millis()
+/// timer) keep running in idle sleep, so loop() can call this instead of
+/// spinning between scan slots.  Afterwards it runs update() for every
+/// display refreshed by the timer.
+///
+void SevSegBase::idle(void)
+{
+#if defined(__AVR__)
+    set_sleep_mode(SLEEP_MODE_IDLE);
+    sleep_enable();
+    sleep_cpu();
+    sleep_disable();
+#elif !defined(ARDUINO)
+    LED_HostSleep();
+#endif
+    for (uint8_t i = 0; i < s_timers; ++i)
+    {
+        s_timer[i]->m_update(s_timer[i]);
+    }
+}
+
+#if LED_POWER
+///
+/// Step the power save state.  Called once per frame from the timer
+/// interrupt when power save is on.  Blanking gates every digit off and
+/// shows one more slot to turn the pins off; the timer rate and a
+/// controller's blank frame are left to applyPower().
+/// @param  now     Current time in milliseconds
+///
+void SevSegBase::tickPower(unsigned long now)
+{
+    if (m_active)
+    {
+        m_active = false;
+        m_idleSince = now;
+        return;
+    }
+    const unsigned long idle = now - m_idleSince;
+    if (m_blankAfter && idle >= m_blankAfter * 1000UL)
+    {
+        m_power = POWER_BLANK;
+        m_powerDue = true;
+#if LED_BRIGHT
+        m_dimmed = false;
+#endif
+        m_gate = DIG_NONE;
+        m_tick(this);
+    }
+    else if (m_lowAfter && m_power == POWER_ON && idle >= m_lowAfter * 1000UL)
+    {
+        m_power = POWER_LOW;
+        m_powerDue = true;
+    }
+}
+
+///
+/// Apply a power state change made in the timer interrupt: set the timer
+/// rate and, once awake, let the digits on again.  Called by commit(),
+/// update() and idle(), never from the interrupt.
+///
+void SevSegBase::applyPower(void)
+{
+    if (!m_powerDue)
+        return;
+    m_powerDue = false;
+#if defined(__AVR__)
+    uint8_t oldSREG = SREG;
+    cli();
+#endif
+    powerRate();
+#if defined(__AVR__)
+    SREG = oldSREG;
+#endif
+    if (m_power != POWER_BLANK)
+        updateGate();
+}
+
+///
+/// Apply a power state change made in the timer interrupt, sending a
+/// blank frame to a controller backend when the display was blanked
+///
+void SevSeg::applyPower(void)
+{
+    if (m_powerDue && m_out && m_power == POWER_BLANK)
+    {
+        enum led_seg blank[MAX_DIGITS];
+        for (uint8_t d = 0; d < m_digits; ++d)
+        {
+            blank[d] = SEG_NONE;
+        }
+        m_out->frame(blank, m_digits);
+    }
+    SevSegBase::applyPower();
+}
+
+///
+/// Leave power save after new content was committed
+///
+void SevSegBase::wake(void)
+{
+#if defined(__AVR__)
+    uint8_t oldSREG = SREG;
+    cli();
+#endif
+    m_power = POWER_ON;
+    powerRate();
+    updateGate();
+#if defined(__AVR__)
+    SREG = oldSREG;
+#endif
+}
+
+///
+/// Set the timer rate for the most active attached display: full rate,
+/// the low rate, or stopped when all displays are blank.
+///
+void SevSegBase::powerRate(void)
+{
+    uint8_t power = POWER_BLANK;
+    for (uint8_t i = 0; i < s_timers; ++i)
+    {
+        if (s_timer[i]->m_power < power)
+            power = s_timer[i]->m_power;
+    }
+    if (power == s_power)
+        return;
+    s_power = power;
+    if (power == POWER_BLANK)
+    {
+        timerStart(0);
+        return;
+    }
+    uint16_t hz = (power == POWER_LOW) ? s_lowHz : s_hz;
+    // Fall back to the full rate if the low rate does not fit the timer
+    if (!timerStart((unsigned long) hz * s_phases))
+    {
+        hz = s_hz;
+        timerStart((unsigned long) hz * s_phases);
+    }
+#if LED_STATS
+    for (uint8_t i = 0; i < s_timers; ++i)
+    {
+        s_timer[i]->m_stats.nominal = 1000000UL / hz;
+        s_timer[i]->resetStats();
+    }
+#endif
+}
+#endif
+
+#if LED_BRIGHT
+///
+/// Store the brightness bits of some digits.  The timer interrupt reads
+/// m_bright[] at every frame, so the bits are written with it held off.
+/// @param  digits  Digits to set
+/// @param  level   Brightness 0 (off) .. LED_BRIGHT_MAX (full)
+///
+void SevSegBase::setBrightBits(enum led_dig digits, uint8_t level)
+{
+    if (level > LED_BRIGHT_MAX)
+        level = LED_BRIGHT_MAX;
+#if defined(__AVR__)
+    uint8_t oldSREG = SREG;
+    cli();
+#endif
+    for (uint8_t b = 0; b < LED_BRIGHT_BITS; ++b)
+    {
+        if (level & (1 << b))
+            m_bright[b] = (enum led_dig)(m_bright[b] | digits);
+        else
+            m_bright[b] = (enum led_dig)(m_bright[b] & ~digits);
+    }
+#if defined(__AVR__)
+    SREG = oldSREG;
+#endif
+}
+
+///
+/// Test whether brightness modulation should run.  It only runs while
+/// refreshed by the timer and some digit is below full brightness.
+/// @return true    if modulated
+///
+boolean SevSegBase::brightDimmed(void)
+{
+    const led_digmask all = LED_DigitMask(m_digits);
+    boolean dimmed = false;
+    for (uint8_t b = 0; b < LED_BRIGHT_BITS; ++b)
+    {
+        if ((m_bright[b] & all) != all)
+            dimmed = true;
+    }
+    return dimmed && s_timers == 1 && s_timer[0] == this;
+}
+
+#endif
+
+///
+/// Rebuild the digit gate: all digits, or the digits of the current
+/// brightness bit while modulated
+///
+void SevSegBase::updateGate(void)
+{
+#if LED_BRIGHT
+    const boolean dimmed = brightDimmed();
+#if defined(__AVR__)
+    uint8_t oldSREG = SREG;
+    cli();
+#endif
+    m_dimmed = dimmed;
+    m_gate = dimmed ? m_bright[m_bcmBit] : LED_DIG_ALL;
+#if defined(__AVR__)
+    SREG = oldSREG;
+#endif
+#else
+    m_gate = LED_DIG_ALL;
+#endif
+}
+
+///
+/// Set the brightness of all digits.  LED controller backends set their
+/// own intensity; with pins and multiplexed backends the timer interrupt
+/// modulates it when the library is built with LED_BRIGHT=1 (see
+/// SevSegCore::setBrightness()).
+/// @param  level   Brightness 0 (off) .. LED_BRIGHT_MAX (full)
+///
+void SevSeg::setBrightness(uint8_t level)
+{
+    if (m_out)
+        m_out->brightness(level);
+#if LED_BRIGHT
+    SevSegCore<SevSeg>::setBrightness(level);
+#endif
+}
+
+#if LED_PORT_IO && LED_BRIGHT
+///
+/// Rebuild the digit gate port images, then the brightness gates
+///
+void SevSeg::updateBrightness(void)
+{
+    if (!m_ports)
+    {
+        updateGate();
+        return;
+    }
+    // Build the new gates aside: the interrupt reads m_brightX[] together
+    // with m_dimmed and m_gate
+    uint8_t brightX[LED_BRIGHT_BITS][LED_MAX_PORTS];
+    for (uint8_t b = 0; b < LED_BRIGHT_BITS; ++b)
+    {
+        uint8_t on[LED_MAX_PORTS];
+        buildImage(on, SEG_NONE, m_bright[b]);
+        for (uint8_t p = 0; p < LED_MAX_PORTS; ++p)
+        {
+            brightX[b][p] = (uint8_t)(on[p] ^ m_digOff[p]);
+        }
+    }
+#if defined(__AVR__)
+    uint8_t oldSREG = SREG;
+    cli();
+#endif
+    memcpy(m_brightX, brightX, sizeof(m_brightX));
+    updateGate();
+#if defined(__AVR__)
+    SREG = oldSREG;
+#endif
+}
+#endif
+
+#if LED_BLINK
+///
+/// Stop blinking (see SevSegCore::setBlink())
+///
+void SevSegBase::stopBlink(void)
+{
+#if defined(__AVR__)
+    uint8_t oldSREG = SREG;
+    cli();
+#endif
+    m_blink = DIG_NONE;
+    m_blinkOff = DIG_NONE;
+#if defined(__AVR__)
+    SREG = oldSREG;
+#endif
+}
+
+///
+/// Start blinking in the on phase once the tables are built
+/// @param  mask    Digits to blink
+/// @param  msec    Milliseconds per phase (on and off)
+///
+void SevSegBase::startBlink(enum led_dig mask, uint16_t msec)
+{
+#if defined(__AVR__)
+    uint8_t oldSREG = SREG;
+    cli();
+#endif
+    m_blink = mask;
+    m_blinkStep = msec ? msec : 1;
+    m_blinkLast = millis();
+#if defined(__AVR__)
+    SREG = oldSREG;
+#endif
+}
+
+///
+/// Rebuild the alternate content tables.  Only called while no digit
+/// blinks (m_blink == DIG_NONE), so the refresh never sees half a table.
+/// @param  mask    Digits that will blink
+///
+void SevSegBase::updateBlink(enum led_dig mask)
+{
+    m_altDigits = DIG_NONE;
+    m_altSegments = 0;
+    for (uint8_t s = 0; s < SEGMENTS; ++s)
+    {
+        m_altPlanes[s] = DIG_NONE;
+    }
+    for (uint8_t d = 0; d < m_digits; ++d)
+    {
+        const enum led_seg seg = (mask & (DIG_0 << d)) ? m_alt[d] : SEG_NONE;
+        if (seg)
+            m_altDigits = (enum led_dig)(m_altDigits | (DIG_0 << d));
+        m_altSegments |= seg;
+        for (uint8_t s = 0; s < SEGMENTS; ++s)
+        {
+            if (seg & (SEG_A << s))
+                m_altPlanes[s] = (enum led_dig)(m_altPlanes[s] | (DIG_0 << d));
+        }
+    }
+}
+
+#if LED_PORT_IO
+///
+/// Rebuild the alternate content tables and their port images
+/// @param  mask    Digits that will blink
+///
+void SevSeg::updateBlink(enum led_dig mask)
+{
+    SevSegBase::updateBlink(mask);
+    if (m_ports)
+    {
+        // Pins of the blinking digits, then their levels per segment slot
+        uint8_t on[LED_MAX_PORTS];
+        buildImage(on, SEG_NONE, mask);
+        for (uint8_t p = 0; p < LED_MAX_PORTS; ++p)
+        {
+            m_blinkX[p] = (uint8_t)((on[p] ^ m_digOff[p]) & m_digPort[p]);
+        }
+        for (uint8_t s = 0; s < SEGMENTS; ++s)
+        {
+            buildImage(m_altX[s], SEG_NONE, m_altPlanes[s]);
+            for (uint8_t p = 0; p < LED_MAX_PORTS; ++p)
+            {
+                m_altX[s][p] &= m_blinkX[p];
+            }
+        }
+        for (uint8_t d = 0; d < m_digits; ++d)
+        {
+            buildImage(m_altImage[d], m_alt[d], (enum led_dig)(DIG_0 << d));
+        }
+    }
+}
+#endif
+#endif
+
+#if LED_KEYS
+///
+/// Scan keys wired between the digit lines and one or two return pins
+/// (through a diode per key, like the TM1637 key matrix).  Every msec
+/// milliseconds the refresh spends one slot with the display blanked and
+/// one digit line driven, and samples the return pins at the start of the
+/// next slot.  Key presses and releases are debounced (two equal samples
+/// in a row) and queued for readKey().  A pressed key reads the digit on
+/// level: return pins are pulled up when that is LOW (common cathode),
+/// otherwise they need a pull-down resistor.  Key slots make the display
+/// slightly darker, by one slot every msec milliseconds.  Needs begin()
+/// with pins; output backends are not supported, and no keys
+/// are scanned while the display is blanked by setPowerSave().
+/// @param  pins    Return pins (not display pins)
+/// @param  count   Number of return pins (1..LED_KEY_RETURNS, 0 = no keypad)
+/// @param  lines   Digit lines with keys
+/// @param  msec    Milliseconds between key slots
+///
+void SevSeg::setKeypad(const uint8_t* pins, uint8_t count, enum led_dig lines, uint8_t msec/*=8*/)
+{
+    if (count > LED_KEY_RETURNS)
+        count = LED_KEY_RETURNS;
+    lines = (enum led_dig)(lines & LED_DigitMask(m_digits));
+    if (m_out || m_pins == 0 || count == 0)
+        lines = DIG_NONE;
+    // Stop the key slots first: the refresh may be the timer interrupt
+#if defined(__AVR__)
+    uint8_t oldSREG = SREG;
+    cli();
+#endif
+    m_keyPhase = KEY_IDLE;
+    m_keyLines = DIG_NONE;
+#if defined(__AVR__)
+    SREG = oldSREG;
+#endif
+    m_keyLevel = (m_config & DIG_INVERT) ? LOW : HIGH;
+    for (uint8_t r = 0; r < count; ++r)
+    {
+        m_keyPins[r] = pins[r];
+        pinMode(pins[r], (m_keyLevel == LOW) ? INPUT_PULLUP : INPUT);
+    }
+    for (uint8_t r = 0; r < LED_KEY_RETURNS; ++r)
+    {
+        m_keyRaw[r] = 0;
+        m_keyDown[r] = 0;
+    }
+    m_keyReturns = count;
+    m_keyStep = msec ? msec : 1;
+    m_keyLast = millis();
+#if defined(__AVR__)
+    oldSREG = SREG;
+    cli();
+#endif
+    m_keyLines = lines;
+#if defined(__AVR__)
+    SREG = oldSREG;
+#endif
+}
+
+///
+/// Get the next key event
+/// @return event   Key number, | KEY_UP for a release, or KEY_NONE
+///
+uint8_t SevSeg::readKey(void)
+{
+    const uint8_t tail = m_keyTail;
+    if (tail == m_keyHead)
+        return KEY_NONE;
+    const uint8_t event = m_keyQueue[tail];
+    m_keyTail = (uint8_t)((tail + 1) & (LED_KEY_QUEUE - 1));
+    return event;
+}
+
+///
+/// Test if a key is held down (debounced)
+/// @param  key     Key number (digit line + MAX_DIGITS * return pin index)
+/// @return down    true if the key is down
+///
+boolean SevSeg::keyDown(uint8_t key)
+{
+    const uint8_t r = (uint8_t)(key / MAX_DIGITS);
+    if (r >= LED_KEY_RETURNS)
+        return false;
+#if defined(__AVR__)
+    uint8_t oldSREG = SREG;
+    cli();
+#endif
+    const led_digmask down = m_keyDown[r];
+#if defined(__AVR__)
+    SREG = oldSREG;
+#endif
+    return (down & (DIG_0 << (key % MAX_DIGITS))) != 0;
+}
+
+///
+/// Run the due key slot step: blank the display and drive the next digit
+/// line (KEY_DRIVE), or sample the return pins after that slot
+/// (KEY_SAMPLE).
+/// @return used    true if the key slot took the place of a display slot
+///
+boolean SevSeg::keySlot(void)
+{
+    if (m_keyPhase == KEY_SAMPLE)
+    {
+        keySample();
+        m_keyPhase = KEY_IDLE;
+        return false;
+    }
+    if (!m_keyLines)
+    {
+        // Keypad turned off while a slot was due
+        m_keyPhase = KEY_IDLE;
+        return false;
+    }
+    uint8_t line = m_keyLine;
+    do
+    {
+        line = (uint8_t)((line + 1 < m_digits) ? line + 1 : 0);
+    } while (!(m_keyLines & (DIG_0 << line)));
+    m_keyLine = line;
+    setDigits(DIG_NONE);
+    setSegments(SEG_NONE);
+    setDigits((enum led_dig)(DIG_0 << line));
+    m_keyPhase = KEY_SAMPLE;
+    return true;
+}
+
+///
+/// Sample the keys of the driven digit line and queue the debounced
+/// changes.  The queue has a single writer (the refresh) and a single
+/// reader (readKey()); events are dropped while it is full.
+///
+void SevSeg::keySample(void)
+{
+    const led_digmask line = (led_digmask)(DIG_0 << m_keyLine);
+    for (uint8_t r = 0; r < m_keyReturns; ++r)
+    {
+        const led_digmask sample = (digitalRead(m_keyPins[r]) == m_keyLevel) ? line : 0;
+        const led_digmask raw = m_keyRaw[r];
+        const led_digmask down = m_keyDown[r];
+        m_keyRaw[r] = (led_digmask)((raw & ~line) | sample);
+        // A level seen twice in a row is taken as the key state
+        if (((raw ^ sample) & line) || !((sample ^ down) & line))
+            continue;
+        m_keyDown[r] = (led_digmask)(down ^ line);
+        const uint8_t head = m_keyHead;
+        const uint8_t next = (uint8_t)((head + 1) & (LED_KEY_QUEUE - 1));
+        if (next == m_keyTail)
+            continue;
+        const uint8_t key = (uint8_t)(m_keyLine + r * MAX_DIGITS);
+        m_keyQueue[head] = (uint8_t)(sample ? key : key | KEY_UP);
+        m_keyHead = next;
+    }
+}
+#endif
+
+void SevSeg::tickDigits(SevSegBase* led)
+{
+    SevSeg* seg = static_cast<SevSeg*>(led);
+#if LED_KEYS
+    // A key slot takes the place of a display slot
+    if (seg->keyTick())
+        return;
+#endif
+    seg->scanDigits();
+}
+
+void SevSeg::tickSegments(SevSegBase* led)
+{
+    SevSeg* seg = static_cast<SevSeg*>(led);
+#if LED_KEYS
+    if (seg->keyTick())
+        return;
+#endif
+    seg->scanSegments();
+}
+
+void SevSeg::tickAuto(SevSegBase* led)
+{
+    SevSeg* seg = static_cast<SevSeg*>(led);
+#if LED_KEYS
+    if (seg->keyTick())
+        return;
+#endif
+    seg->scanAuto();
+}
+
+#if LED_PORT_IO
+///
+/// Resolve the pin array into output port registers and bit masks.
+/// Falls back to digitalWrite() if the pins span more than LED_MAX_PORTS.
+///
+void SevSeg::mapPins(void)
+{
+    uint8_t ports = 0;
+    for (uint8_t p = 0; p < LED_MAX_PORTS; ++p)
+    {
+        m_segPort[p] = 0;
+        m_digPort[p] = 0;
+    }
+    for (uint8_t i = 0; i < SEGMENTS + m_digits; ++i)
+    {
+        uint8_t port = digitalPinToPort(m_pins[i]);
+        uint8_t bit = digitalPinToBitMask(m_pins[i]);
+        if (port == NOT_A_PIN || bit == 0)
+        {
+            m_ports = 0;
+            return;
+        }
+        led_port* reg = portOutputRegister(port);
+        uint8_t p = 0;
+        while (p < ports && m_portReg[p] != reg)
+            ++p;
+        if (p == ports)
+        {
+            if (ports == LED_MAX_PORTS)
+            {
+                m_ports = 0;
+                return;
+            }
+            m_portReg[ports++] = reg;
+        }
+        uint8_t shift = 0;
+        while (!(bit & 0x01))
+        {
+            bit >>= 1;
+            ++shift;
+        }
+        m_pinMap[i] = (uint8_t)((p << 3) | shift);
+        if (i < SEGMENTS)
+            m_segPort[p] |= (uint8_t)(1 << shift);
+        else
+            m_digPort[p] |= (uint8_t)(1 << shift);
+    }
+    m_ports = ports;
+    for (uint8_t p = 0; p < ports; ++p)
+    {
+        m_shadow[p] = *m_portReg[p];
+    }
+    buildImage(m_digOff, SEG_NONE, DIG_NONE);
+    m_images[0].mode = SCAN_NONE;
+    m_images[1].mode = SCAN_NONE;
+#if LED_BRIGHT
+    updateBrightness();
+#endif
+}
+
+///
+/// Build the per-port output image for a segment and digit mask
+/// @param  image   Port image (LED_MAX_PORTS bytes)
+/// @param  seg     Segment mask (SEG_A..SEG_DP)
+/// @param  dig     Digit mask (DIG_0..DIG_n-1)
+///
+void SevSeg::buildImage(uint8_t* image, enum led_seg seg, enum led_dig dig)
+{
+    uint8_t segBits = (m_config & SEG_INVERT) ? (uint8_t)~seg : (uint8_t)seg;
+    led_digmask digBits = (m_config & DIG_INVERT) ? (led_digmask)~dig : (led_digmask)dig;
+    for (uint8_t p = 0; p < LED_MAX_PORTS; ++p)
+    {
+        image[p] = 0;
+    }
+    for (uint8_t i = 0; i < SEGMENTS; ++i)
+    {
+        if (segBits & 0x01)
+            image[m_pinMap[i] >> 3] |= (uint8_t)(1 << (m_pinMap[i] & 7));
+        segBits >>= 1;
+    }
+    for (uint8_t i = 0; i < m_digits; ++i)
+    {
+        if (digBits & 0x01)
+            image[m_pinMap[i + SEGMENTS] >> 3] |= (uint8_t)(1 << (m_pinMap[i + SEGMENTS] & 7));
+        digBits >>= 1;
+    }
+}
+
+///
+/// Write the masked bits of a port image to the output ports
+/// @param  image   Port image (LED_MAX_PORTS bytes)
+/// @param  mask    Bits to update per port (m_segPort or m_digPort)
+///
+void SevSeg::writePorts(const uint8_t* image, const uint8_t* mask)
+{
+#if defined(__AVR__)
+    // Port bits may be shared with pins written from other ISRs
+    uint8_t oldSREG = SREG;
+    cli();
+#endif
+    for (uint8_t p = 0; p < m_ports; ++p)
+    {
+        // Skip ports whose LED pins already have these levels
+        const uint8_t bits = mask[p];
+        if ((image[p] ^ m_shadow[p]) & bits)
+        {
+            led_port* reg = m_portReg[p];
+            m_shadow[p] = (uint8_t)((m_shadow[p] & ~bits) | (image[p] & bits));
+            *reg = (uint8_t)((*reg & ~bits) | (image[p] & bits));
+        }
+    }
+#if defined(__AVR__)
+    SREG = oldSREG;
+#endif
+}
+
+///
+/// Show one scan slot: digits leaving off, segments, then the slot's
+/// digits that are gated on for the current brightness frame.  Digits lit
+/// in both slots stay on, and unchanged ports are not written.
+/// @param  image   Port image of the slot
+///
+void SevSeg::outputImage(const uint8_t* image)
+{
+    uint8_t keep[LED_MAX_PORTS];
+    uint8_t digits[LED_MAX_PORTS];
+    // All digits, none (blanked by power save) or the current brightness bit
+#if LED_BRIGHT
+    const uint8_t* gate = m_dimmed ? m_brightX[m_bcmBit] : m_gate ? s_gateOn : s_gateOff;
+#else
+    const uint8_t* gate = m_gate ? s_gateOn : s_gateOff;
+#endif
+    for (uint8_t p = 0; p < m_ports; ++p)
+    {
+        // Gate in active-level space so it works for either polarity
+        const uint8_t on = (uint8_t)((image[p] ^ m_digOff[p]) & gate[p]);
+        keep[p] = (uint8_t)((on & (m_shadow[p] ^ m_digOff[p])) ^ m_digOff[p]);
+        digits[p] = (uint8_t)(on ^ m_digOff[p]);
+    }
+    writePorts(keep, m_digPort);
+    writePorts(image, m_segPort);
+    writePorts(digits, m_digPort);
+}
+
+///
+/// Render the port images for every scan slot of a page
+/// @param  page    Display page
+/// @param  mode    SCAN_DIGITS or SCAN_SEGMENTS
+///
+void SevSeg::renderImages(struct led_page* page, enum led_scan mode)
+{
+    struct led_images* images = imagesOf(page);
+    if (mode == SCAN_DIGITS)
+    {
+        for (uint8_t d = 0; d < m_digits; ++d)
+        {
+            buildImage(images->image[d], page->buf[d], (enum led_dig)(DIG_0 << d));
+        }
+    }
+    else
+    {
+        for (uint8_t s = 0; s < SEGMENTS; ++s)
+        {
+            enum led_seg segMask = (enum led_seg)(SEG_A << s);
+            buildImage(images->image[s], segMask, page->planes[s]);
+        }
+    }
+    images->mode = mode;
+}
+
+///
+/// Rebuild the port images of a page for the dirty digits (SCAN_DIGITS)
+/// or the changed segment planes (SCAN_SEGMENTS)
+/// @param  page    Display page
+/// @param  planes  Bit mask of the changed planes (from buildPlanes())
+///
+void SevSeg::updateImages(struct led_page* page, uint8_t planes)
+{
+    struct led_images* images = imagesOf(page);
+    if (images->mode == SCAN_DIGITS)
+    {
+        for (uint8_t d = 0; d < m_digits; ++d)
+        {
+            if (m_dirty & (DIG_0 << d))
+                buildImage(images->image[d], page->buf[d], (enum led_dig)(DIG_0 << d));
+        }
+    }
+    else
+    {
+        for (uint8_t s = 0; s < SEGMENTS; ++s)
+        {
+            if (planes & (1 << s))
+                buildImage(images->image[s], (enum led_seg)(SEG_A << s), page->planes[s]);
+        }
+    }
+}
+
+///
+/// Render the port images of the displayed page for the timer scan mode
+/// @param  page    Displayed page
+/// @param  mode    SCAN_DIGITS or SCAN_SEGMENTS
+///
+void SevSeg::renderPage(struct led_page* page, enum led_scan mode)
+{
+    if (m_ports)
+        renderImages(page, mode);
+}
+#endif
+
+///
+/// Show number as hexadecimal right justified on the LED display
+/// @param num     Number to display
+///
+void SevSegBase::showHex(unsigned long num)
+{
+    beginUpdate();
+    for (uint8_t d = m_digits; d > 0; --d)
+    {
+        drawDigit(d - 1, (enum led_seg)pgm_read_byte_near(LED_HexFont + (num & 15)));
+        num >>= 4;
+    }
+    endUpdate();
+}
+
+/// Powers of 10 for division-free decimal conversion
+const PROGMEM uint32_t LED_Pow10[10] =
+{
+    1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL,
+    1000000UL, 10000000UL, 100000000UL, 1000000000UL
+};
+
+#if LED_NUMBER_DIGITS > 10
+/// Powers of 10 from 10^10 for 64-bit numbers (LED_MAX_DIGITS > 10)
+const PROGMEM led_number LED_Pow10L[LED_NUMBER_DIGITS - 10] =
+{
+    10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+    100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+    100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+#endif
+
+///
+/// Show number as unsigned decimal with [optional] decimal point
+/// right justified on the LED display.  Digits are found by repeated
+/// subtraction of powers of 10 (no 32-bit divisions, which are library
+/// calls on AVR).
+/// @param num     Number to display
+/// @param dp      Number of decimal places (-1 if no decimal point)
+/// @param fill    Fill char (' ', '-' or '+')
+///
+void SevSegBase::showNumber(led_number num, uint8_t dp, enum led_seg fill/*=SEG_NONE*/)
+{
+    beginUpdate();
+    led_number n = num;
+    uint8_t dec[LED_NUMBER_DIGITS]; // Decimal digits, dec[0] = ones
+    uint8_t width = 1;              // Number of significant digits
+    for (uint8_t p = LED_NUMBER_DIGITS - 1; p > 0; --p)
+    {
+#if LED_NUMBER_DIGITS > 10
+        led_number pow;
+        if (p >= 10)
+            memcpy_P(&pow, LED_Pow10L + p - 10, sizeof(pow));
+        else
+            pow = pgm_read_dword(LED_Pow10 + p);
+#else
+        const uint32_t pow = pgm_read_dword(LED_Pow10 + p);
+#endif
+        uint8_t count = 0;
+        while (n >= pow)
+        {
+            n -= pow;
+            ++count;
+        }
+        dec[p] = count;
+        if (count && width == 1)
+            width = p + 1;
+    }
+    dec[0] = (uint8_t) n;
+    // Show at least the digits up to the decimal point (all if dp = -1)
+    if (width <= dp)
+        width = (dp < m_digits) ? dp + 1 : m_digits;
+
+    for (uint8_t d = 0; d < m_digits; ++d)
+    {
+        uint8_t mask;
+        if (d < width)
+        {
+            mask = pgm_read_byte_near(LED_HexFont + ((d < LED_NUMBER_DIGITS) ? dec[d] : 0));
+        }
+        else
+        {
+            mask = fill;
+            // Insure only one '-' sign
+            if (fill != LED_0)
+            {
+                fill = LED_BLANK;
+            }
+        }
+        drawDigit(m_digits - d - 1, (enum led_seg)((d == dp) ? (mask | SEG_DP) : mask));
+    }
+    endUpdate();
+}
+
+///
+/// Show number as signed decimal with [optional] decimal point
+/// right justified on the LED display.
+/// @param num     Number to display
+/// @param dp      Decimal Places (-1 if no decimal point)
+///
+void SevSegBase::showDecimal(led_signed num, uint8_t dp)
+{
+    if (num < 0)
+    {
+        showNumber(-num, dp, LED_MINUS);
+    }
+    else
+    {
+        showNumber(num, dp, LED_BLANK);
+    }
+}
+
+///
+/// Read the next glyph of a string, folding a following '.' into its
+/// decimal point so "12.5" takes 3 digits.  Stays at the terminating NUL.
+/// @param  str     String pointer, advanced past the glyph
+/// @param  flash   true if the string is in flash (PROGMEM)
+/// @return mask    Segments of the glyph (LED_BLANK at the end)
+///
+static enum led_seg nextGlyph(const char*& str, uint8_t flash)
+{
+    uint8_t c = flash ? pgm_read_byte_near(str) : (uint8_t) *str;
+    if (c == 0)
+        return LED_BLANK;
+    ++str;
+    c -= ' ';
+    uint8_t mask = LED_GET_FONT(LED_AsciiFont, c);
+    if (c != '.' - ' ')
+    {
+        uint8_t next = flash ? pgm_read_byte_near(str) : (uint8_t) *str;
+        if (next == '.')
+        {
+            mask |= SEG_DP;
+            ++str;
+        }
+    }
+    return (enum led_seg) mask;
+}
+
+///
+/// Show text string as ASCII characters with [optional] decimal
+/// point left justified on the LED display.  Digits past the end of the
+/// string are blank.
+/// @param str     Text string to display
+///
+void SevSegBase::showText(const char* str)
+{
+    beginUpdate();
+    for (uint8_t d = 0; d < m_digits; ++d)
+    {
+        drawDigit(d, nextGlyph(str, false));
+    }
+    endUpdate();
+}
+
+#if LED_PLAYER
+///
+/// Scroll a text string across the display.  The marquee is advanced by
+/// refreshDigits()/refreshSegments() or the timer interrupt and update(),
+/// so loop() does no per-step work; glyphs are read straight from the string (no
+/// copy is made, so RAM strings must stay valid).  Any other show*() call
+/// or commit() stops the marquee.
+/// @param str     Text string to scroll
+/// @param msec    Milliseconds per step
+/// @param mode    MARQUEE_LOOP, MARQUEE_BOUNCE or MARQUEE_ONCE
+///
+void SevSegBase::showMarquee(const char* str, uint16_t msec, enum led_marquee mode/*=MARQUEE_LOOP*/)
+{
+    startMarquee(str, false, msec, mode);
+}
+
+///
+/// Scroll a flash string (F("...")) across the display.
+/// @copydetails SevSegBase::showMarquee(const char*,uint16_t,enum led_marquee)
+///
+void SevSegBase::showMarquee(const __FlashStringHelper* str, uint16_t msec, enum led_marquee mode/*=MARQUEE_LOOP*/)
+{
+    startMarquee((const char*) str, true, msec, mode);
+}
+
+///
+/// Test whether a marquee is running (MARQUEE_ONCE stops by itself)
+/// @return true    if the marquee is running
+///
+boolean SevSegBase::marqueeBusy(void)
+{
+    return m_playMode != MARQUEE_OFF && m_playRender == stepMarquee;
+}
+
+///
+/// Start a marquee.  The first step is shown at the next refresh.
+///
+void SevSegBase::startMarquee(const char* str, uint8_t flash, uint16_t msec, enum led_marquee mode)
+{
+    // Stops any running marquee and waits for its last step to be shown
+    beginUpdate();
+    int16_t len = 0;
+    const char* end = str;
+    while (flash ? pgm_read_byte_near(end) : (uint8_t) *end)
+    {
+        nextGlyph(end, flash);
+        ++len;
+    }
+    m_mqText = str;
+    m_mqFlash = flash;
+    m_playStep = msec;
+    m_playLast = millis() - msec;
+    m_mqDir = 1;
+    m_mqLen = len;
+    m_mqPos = (mode == MARQUEE_BOUNCE) ? 0 : (int16_t)(1 - m_digits);
+    // Called through a pointer so the font is only linked with the marquee
+    m_playRender = stepMarquee;
+    m_playMode = mode;
+}
+
+///
+/// Draw the current marquee step into the back page for update() to
+/// commit and advance to the next step.
+///
+void SevSegBase::renderMarquee(void)
+{
+    const char* str = m_mqText;
+    const int16_t pos = m_mqPos;
+    // Skip the glyphs scrolled off to the left
+    for (int16_t g = 0; g < pos; ++g)
+    {
+        nextGlyph(str, m_mqFlash);
+    }
+    m_buf = m_page[m_front ^ 1].buf;
+    for (uint8_t d = 0; d < m_digits; ++d)
+    {
+        drawDigit(d, (pos + d < 0) ? LED_BLANK : nextGlyph(str, m_mqFlash));
+    }
+    m_playDue = true;
+
+    switch (m_playMode)
+    {
+    case MARQUEE_BOUNCE:
+        if (m_mqLen > m_digits)
+        {
+            if (pos + m_mqDir < 0 || pos + m_mqDir > m_mqLen - m_digits)
+                m_mqDir = (int8_t) -m_mqDir;
+            m_mqPos = (int16_t)(pos + m_mqDir);
+        }
+        break;
+    case MARQUEE_ONCE:
+        // Stop after the step with the last glyph scrolled off
+        if (pos >= m_mqLen)
+            m_playMode = MARQUEE_OFF;
+        else
+            m_mqPos = (int16_t)(pos + 1);
+        break;
+    default:
+        m_mqPos = (pos + 1 < m_mqLen) ? (int16_t)(pos + 1) : (int16_t)(1 - m_digits);
+        break;
+    }
+}
+
+void SevSegBase::stepMarquee(SevSegBase* led)
+{
+    led->renderMarquee();
+}
+
+///
+/// Play an animation from flash.  Frames are played by refreshDigits()/
+/// refreshSegments() or the timer interrupt and update(), so loop() does
+/// no per-frame work.  Any other show*() call or commit() stops the animation.
+/// @param frames  PROGMEM table of count frames of digitCount() segment masks
+/// @param count   Number of frames
+/// @param msec    PROGMEM table of count frame durations in milliseconds
+/// @param mode    MARQUEE_LOOP, MARQUEE_BOUNCE (forwards then backwards)
+///                or MARQUEE_ONCE (stop on the last frame)
+///
+void SevSegBase::showAnimation(const enum led_seg* frames, uint8_t count, const uint16_t* msec,
+                           enum led_marquee mode/*=MARQUEE_LOOP*/)
+{
+    beginUpdate();
+    startAnimation(frames, count, msec, 0, mode);
+}
+
+///
+/// Play an animation from flash with the same duration for every frame.
+/// @param frames  PROGMEM table of count frames of digitCount() segment masks
+/// @param count   Number of frames
+/// @param msec    Milliseconds per frame
+/// @param mode    MARQUEE_LOOP, MARQUEE_BOUNCE or MARQUEE_ONCE
+///
+void SevSegBase::showAnimation(const enum led_seg* frames, uint8_t count, uint16_t msec,
+                           enum led_marquee mode/*=MARQUEE_LOOP*/)
+{
+    beginUpdate();
+    startAnimation(frames, count, 0, msec, mode);
+}
+
+///
+/// Play a built-in test pattern sized to the display.
+/// @param anim    ANIM_SEGMENT_WALK, ANIM_ALL_ON or ANIM_SPINNER
+/// @param msec    Milliseconds per frame
+/// @param mode    MARQUEE_LOOP, MARQUEE_BOUNCE or MARQUEE_ONCE
+///
+void SevSegBase::showAnimation(enum led_anim anim, uint16_t msec, enum led_marquee mode/*=MARQUEE_LOOP*/)
+{
+    uint8_t count = 1;
+    if (anim == ANIM_SEGMENT_WALK)
+#if LED_MAX_DIGITS * 8 > 255
+        count = (uint8_t)((m_digits * SEGMENTS > 255) ? 255 : m_digits * SEGMENTS);
+#else
+        count = (uint8_t)(SEGMENTS * m_digits);
+#endif
+    else if (anim == ANIM_SPINNER)
+        count = 6;
+    beginUpdate();
+    m_anKind = anim;
+    startAnimation(0, count, 0, msec, mode);
+}
+
+///
+/// Test whether an animation is playing (MARQUEE_ONCE stops by itself)
+/// @return true    if the animation is playing
+///
+boolean SevSegBase::animationBusy(void)
+{
+    return m_playMode != MARQUEE_OFF && m_playRender == stepAnimation;
+}
+
+///
+/// Set a function to call when a MARQUEE_ONCE animation ends.  It is
+/// never called from the timer interrupt: the polled refresh methods,
+/// update() and idle() call it, so it may show new content.
+/// @param done    Function to call (0 = none)
+///
+void SevSegBase::setAnimationDone(void (*done)(SevSegBase* led))
+{
+    m_anDone = done;
+}
+
+///
+/// Run the animation done function if an animation ended (see
+/// SevSegCore::update())
+///
+void SevSegBase::playEnded(void)
+{
+    if (m_anEnded)
+    {
+        m_anEnded = false;
+        if (m_anDone)
+            m_anDone(this);
+    }
+}
+
+///
+/// Start an animation.  The first frame is shown at the next refresh.
+/// Call beginUpdate() first to stop a running marquee or animation.
+///
+void SevSegBase::startAnimation(const enum led_seg* frames, uint8_t count, const uint16_t* times,
+                            uint16_t msec, enum led_marquee mode)
+{
+    m_anFrames = frames;
+    m_anTimes = times;
+    m_anStep = msec;
+    m_anCount = count;
+    m_anFrame = 0;
+    m_anDir = 1;
+    m_playStep = 0;
+    m_playLast = millis();
+    m_playRender = stepAnimation;
+    m_playMode = count ? mode : MARQUEE_OFF;
+}
+
+///
+/// Get one digit of an animation frame
+/// @param  frame   Frame index
+/// @param  digit   Digit index (0 = leftmost)
+/// @return mask    Segments to show
+///
+enum led_seg SevSegBase::animationGlyph(uint8_t frame, uint8_t digit)
+{
+    if (m_anFrames)
+        return (enum led_seg) pgm_read_byte_near(m_anFrames + (uint16_t) frame * m_digits + digit);
+    switch (m_anKind)
+    {
+    case ANIM_SEGMENT_WALK:
+        // Frame digit * SEGMENTS + s shows segments A..s on that digit
+        if (frame / SEGMENTS != digit)
+            return SEG_NONE;
+        return (enum led_seg)((SEG_B << (frame % SEGMENTS)) - 1);
+    case ANIM_SPINNER:
+        return (enum led_seg)(SEG_A << frame);
+    default:
+        return (enum led_seg) 0xFF;
+    }
+}
+
+///
+/// Draw the current animation frame into the back page for update() to
+/// commit and advance to the next frame.
+///
+void SevSegBase::renderAnimation(void)
+{
+    uint8_t frame = m_anFrame;
+    if (frame >= m_anCount)
+    {
+        // MARQUEE_ONCE: the last frame has been shown for its duration
+        m_playMode = MARQUEE_OFF;
+        m_anEnded = true;
+        return;
+    }
+    m_buf = m_page[m_front ^ 1].buf;
+    for (uint8_t d = 0; d < m_digits; ++d)
+    {
+        drawDigit(d, animationGlyph(frame, d));
+    }
+    m_playDue = true;
+    m_playStep = m_anTimes ? pgm_read_word_near(m_anTimes + frame) : m_anStep;
+
+    switch (m_playMode)
+    {
+    case MARQUEE_BOUNCE:
+        if (m_anCount > 1)
+        {
+            if ((int16_t) frame + m_anDir < 0 || (int16_t) frame + m_anDir >= m_anCount)
+                m_anDir = (int8_t) -m_anDir;
+            frame = (uint8_t)(frame + m_anDir);
+        }
+        break;
+    case MARQUEE_ONCE:
+        ++frame;
+        break;
+    default:
+        frame = (uint8_t)((frame + 1 < m_anCount) ? frame + 1 : 0);
+        break;
+    }
+    m_anFrame = frame;
+}
+
+void SevSegBase::stepAnimation(SevSegBase* led)
+{
+    led->renderAnimation();
+}
+#endif
+
+///
+/// Show raw segments (A-F + decimal point) left justified on the LED display.
+/// Useful for displaying graphics and other special symbols.
+/// @param buf     Buffer of segment masks
+///
+void SevSegBase::showRaw(const enum led_seg* buf)
+{
+    beginUpdate();
+    for (uint8_t b = 0; b < m_digits; ++b)
+    {
+        drawDigit(b, buf[b]);
+    }
+    endUpdate();
+}
+
+///
+/// Show raw segments from flash (PROGMEM), e.g. a frame defined with
+/// LED_TEXT(), left justified on the LED display.
+/// @param buf     Buffer of segment masks in flash
+///
+void SevSegBase::showRaw_P(const enum led_seg* buf)
+{
+    beginUpdate();
+    for (uint8_t b = 0; b < m_digits; ++b)
+    {
+        drawDigit(b, (enum led_seg)pgm_read_byte_near(buf + b));
+    }
+    endUpdate();
+}
+
+///
+/// Show raw segments on one digit, leaving the other digits unchanged.
+/// @param index   Digit index (0 = leftmost)
+/// @param mask    Segment mask (SEG_A..SEG_DP)
+///
+void SevSegBase::setDigit(uint8_t index, enum led_seg mask)
+{
+    setRange(index, &mask, 1);
+}
+
+///
+/// Show raw segments on a range of digits, leaving the other digits
+/// unchanged.  Only digits whose segments change are re-rendered.
+/// @param index   First digit index (0 = leftmost)
+/// @param buf     Buffer of segment masks
+/// @param count   Number of digits
+///
+void SevSegBase::setRange(uint8_t index, const enum led_seg* buf, uint8_t count)
+{
+    beginUpdate();
+    for (uint8_t b = 0; b < count && index + b < m_digits; ++b)
+    {
+        drawDigit(index + b, buf[b]);
+    }
+    endUpdate();
+}
+
+#if LED_STATS
+///
+/// Get a snapshot of the refresh statistics.  While refreshed by the timer
+/// with brightness modulation, slots are intentionally shorter than the
+/// nominal interval, so minInterval is down to 1/LED_BRIGHT_MAX of it.
+/// @param stats   Returns the statistics
+///
+void SevSegBase::getStats(struct led_stats* stats)
+{
+#if defined(__AVR__)
+    uint8_t oldSREG = SREG;
+    cli();
+#endif
+    *stats = m_stats;
+#if defined(__AVR__)
+    SREG = oldSREG;
+#endif
+}
+
+///
+/// Clear the refresh statistics (the nominal slot interval is kept)
+///
+void SevSegBase::resetStats(void)
+{
+#if defined(__AVR__)
+    uint8_t oldSREG = SREG;
+    cli();
+#endif
+    m_stats.frames = 0;
+    m_stats.slots = 0;
+    m_stats.late = 0;
+    m_stats.missed = 0;
+    m_stats.minInterval = 0xFFFFFFFFUL;
+    m_stats.maxInterval = 0;
+    m_stats.maxMicros = 0;
+#if defined(__AVR__)
+    SREG = oldSREG;
+#endif
+}
+
+#if defined(ARDUINO)
+///
+/// Print the refresh statistics as one line of name=value pairs, e.g.
+/// "frames=1250 slots=10000 late=3 missed=4 nominal=1000 min=996 max=3072 busy=68"
+/// @param out     Output stream (default Serial)
+///
+void SevSegBase::printStats(Print& out)
+{
+    struct led_stats stats;
+    getStats(&stats);
+    out.print(F("frames="));
+    out.print(stats.frames);
+    out.print(F(" slots="));
+    out.print(stats.slots);
+    out.print(F(" late="));
+    out.print(stats.late);
+    out.print(F(" missed="));
+    out.print(stats.missed);
+    out.print(F(" nominal="));
+    out.print(stats.nominal);
+    out.print(F(" min="));
+    out.print(stats.slots > 1 ? stats.minInterval : 0);
+    out.print(F(" max="));
+    out.print(stats.maxInterval);
+    out.print(F(" busy="));
+    out.println(stats.maxMicros);
 }
+#endif
+#endif
@@ -17,6 +17,17 @@
 /// @example showText.ino
 /// @example showHex.ino
 /// @example showDecimal.ino
+/// @example staticPins.ino
+/// @example benchNumber.ino
+/// @example benchRefresh.ino
+/// @example showDrivers.ino
+/// @example showPrint.ino
+/// @example benchPrint.ino
+/// @example showAnimation.ino
+/// @example twoDisplays.ino
+/// @example benchSuite.ino
+/// @example lowPower.ino
+/// @example keypad.ino
 ///
 
 #if defined(ARDUINO) && ARDUINO >= 100
@@ -25,6 +36,10 @@
 //#include "WProgram.h"
     #define PROGMEM
     #define pgm_read_byte_near(x)   (*(uint8_t*) (x))
+    #define pgm_read_word_near(x)   (*(const uint16_t*) (x))
+    #define pgm_read_dword(x)       (*(const uint32_t*) (x))
+    #define memcpy_P(d, s, n)       memcpy(d, s, n)
+    #include <string.h>
 #endif
 
 #ifdef _MSC_VER
@@ -36,6 +51,142 @@
     #include <stdint.h>
 #endif
 
+#if !defined(ARDUINO)
+    #include "LEDHost.h"
+#else
+    typedef volatile uint8_t led_port;      //!< Output port register type
+#endif
+
+/// Drive the LED pins with direct (masked) port register writes instead of
+/// digitalWrite().  Defaults to on for AVR and the host build; define as 0
+/// to force the portable digitalWrite() path.
+#if !defined(LED_PORT_IO)
+  #if defined(__AVR__) || !defined(ARDUINO)
+    #define LED_PORT_IO     1
+  #else
+    #define LED_PORT_IO     0
+  #endif
+#endif
+
+/// Maximum number of distinct output ports for direct port output
+#define LED_MAX_PORTS       3
+
+/// Maximum number of digits (1..32).  Sets the width of the digit masks
+/// (8, 16 or 32 bits) and the size of the display buffers, so keep it at
+/// the default 8 (or lower) unless a display has more digits, e.g. 12 or
+/// 16 digits on chained shift registers or MAX7219s.
+#if !defined(LED_MAX_DIGITS)
+    #define LED_MAX_DIGITS  8
+#endif
+
+#if LED_MAX_DIGITS <= 8
+typedef uint8_t led_digmask;                //!< Digit mask (bit d = digit d)
+#elif LED_MAX_DIGITS <= 16
+typedef uint16_t led_digmask;               //!< Digit mask (bit d = digit d)
+#elif LED_MAX_DIGITS <= 32
+typedef uint32_t led_digmask;               //!< Digit mask (bit d = digit d)
+#else
+#error "LED_MAX_DIGITS: at most 32 digits"
+#endif
+
+/// Decimal digits shown by SevSeg::showNumber(): 32-bit numbers (10 digits)
+/// unless the display can have more digits, then 64-bit numbers.
+#if LED_MAX_DIGITS > 10
+typedef unsigned long long led_number;      //!< Number shown by showNumber()
+typedef signed long long led_signed;        //!< Number shown by showDecimal()
+#define LED_NUMBER_DIGITS   20
+#else
+typedef unsigned long led_number;           //!< Number shown by showNumber()
+typedef signed long led_signed;             //!< Number shown by showDecimal()
+#define LED_NUMBER_DIGITS   10
+#endif
+
+/// Hardware timer used by SevSeg::attachTimer() on AVR: 0=none, 1=Timer1,
+/// 2=Timer2.  Pick one not used by other libraries (Servo uses Timer1,
+/// tone() uses Timer2).  The host build always uses a simulated timer.
+#if !defined(LED_TIMER)
+    #define LED_TIMER       0
+#endif
+
+/// Maximum number of displays refreshed by the timer (see
+/// SevSeg::attachTimer()).
+#if !defined(LED_MAX_DISPLAYS)
+    #define LED_MAX_DISPLAYS 4
+#endif
+
+/// Scan slots serviced per timer tick.  With more displays attached the
+/// displays take turns on successive ticks and the tick rate is raised to
+/// keep every display at its own slot rate.
+#if !defined(LED_TICK_SLOTS)
+    #define LED_TICK_SLOTS  1
+#endif
+
+/// Modulate the brightness from the timer (see SevSeg::setBrightness()).
+/// Off by default, which saves the brightness bits and gate images (about
+/// 30 bytes of RAM per display); define as 1 to dim digits.  LED
+/// controller backends set their own brightness either way.
+#if !defined(LED_BRIGHT)
+    #define LED_BRIGHT      0
+#endif
+
+/// Number of brightness bits (levels 0..LED_BRIGHT_MAX).  Brightness is
+/// binary code modulated over LED_BRIGHT_BITS frames with timer periods
+/// weighted 1, 2, 4, 8...
+#if !defined(LED_BRIGHT_BITS)
+    #define LED_BRIGHT_BITS 4
+#endif
+#define LED_BRIGHT_MAX      ((1 << LED_BRIGHT_BITS) - 1)
+
+/// Shortest brightness unit (slot of the lowest brightness bit) in
+/// microseconds.  The unit is 1/LED_BRIGHT_MAX of a slot, but never less
+/// than this, so the interrupt handler always finishes within a slot.
+/// Dimmed frames then take longer than hz asks for.
+#if !defined(LED_BRIGHT_MIN_US)
+    #define LED_BRIGHT_MIN_US 100
+#endif
+
+/// Collect refresh statistics (see SevSeg::getStats()).  Off by default;
+/// define as 1 to measure frame rate, slot jitter and refresh cost.
+#if !defined(LED_STATS)
+    #define LED_STATS       0
+#endif
+
+/// Blink digits from the refresh (see SevSeg::setBlink()).  Off by
+/// default, which saves the blink tables (about 75 bytes of RAM per
+/// display); define as 1 to blink.
+#if !defined(LED_BLINK)
+    #define LED_BLINK       0
+#endif
+
+/// Scan keys on the digit lines (see SevSeg::setKeypad()).  Off by
+/// default; define as 1 to add the key slot and queue.
+#if !defined(LED_KEYS)
+    #define LED_KEYS        0
+#endif
+
+/// Play marquees and animations from the refresh (see
+/// SevSeg::showMarquee() and SevSeg::showAnimation()).  Off by default,
+/// which saves the player state (about 40 bytes of RAM per display);
+/// define as 1 to play.
+#if !defined(LED_PLAYER)
+    #define LED_PLAYER      0
+#endif
+
+/// Save power while the content does not change (see
+/// SevSeg::setPowerSave()).  Off by default; define as 1 to add the
+/// power save state.
+#if !defined(LED_POWER)
+    #define LED_POWER       0
+#endif
+
+/// Key return pins (each reads one key per digit line)
+#define LED_KEY_RETURNS     2
+
+/// Key event queue length (power of 2)
+#if !defined(LED_KEY_QUEUE)
+    #define LED_KEY_QUEUE   8
+#endif
+
 /*! 
  *  @defgroup Types Type definitions
  *  @brief Types
@@ -163,8 +314,32 @@ enum led_seg
     LED_DEGREE= SEG_G|SEG_F|                  SEG_B|SEG_A            /*!< Font char Degree */
 };
 
+/*!
+ *  @ingroup Macros
+ *  Glyphs of the 96 printable ASCII characters (' '..'~' + degree), shared
+ *  by LED_AsciiFont and the compile-time LED_TEXT() tables.
+ *  @brief ASCII glyph list
+ */
+#define LED_ASCII_GLYPHS \
+    LED_BLANK,  LED_EXCLAM, LED_DQUOTE, LED_POUND,  LED_DOLLAR,  LED_PERCENT,LED_AMPER,  LED_SQUOTE, \
+    LED_LPAREN, LED_RPAREN, LED_ASTER,  LED_PLUS,   LED_COMMA,   LED_MINUS,  LED_PERIOD, LED_SLASH, \
+    LED_0,      LED_1,      LED_2,      LED_3,      LED_4,      LED_5,      LED_6,      LED_7, \
+    LED_8,      LED_9,      LED_COLON,  LED_SEMI,   LED_LESS,   LED_EQUAL,  LED_GREAT,  LED_QUEST, \
+    LED_ATSIGN, LED_A,      LED_B,      LED_C,      LED_D,      LED_E,      LED_F,      LED_G, \
+    LED_H,      LED_I,      LED_J,      LED_K,      LED_L,      LED_M,      LED_N,      LED_O, \
+    LED_P,      LED_Q,      LED_R,      LED_S,      LED_T,      LED_U,      LED_V,      LED_W, \
+    LED_X,      LED_Y,      LED_Z,      LED_LBRACK, LED_BSLASH, LED_RBRACK, LED_CARET,  LED_UNDER, \
+    LED_ACCENT, LED_a,      LED_b,      LED_c,      LED_d,      LED_e,      LED_f,      LED_g, \
+    LED_h,      LED_i,      LED_j,      LED_k,      LED_l,      LED_m,      LED_n,      LED_o, \
+    LED_p,      LED_q,      LED_r,      LED_s,      LED_t,      LED_u,      LED_v,      LED_w, \
+    LED_x,      LED_y,      LED_z,      LED_LBRACE, LED_VERTBAR,LED_RBRACE, LED_TILDE,  LED_DEGREE
+
 extern const PROGMEM enum led_seg LED_AsciiFont[96];
 extern const PROGMEM enum led_seg LED_HexFont[16];
+extern const PROGMEM uint32_t LED_Pow10[10];
+#if LED_NUMBER_DIGITS > 10
+extern const PROGMEM led_number LED_Pow10L[LED_NUMBER_DIGITS - 10];
+#endif
 
 /*!
  *  @defgroup Macros #define Macros
@@ -185,8 +360,8 @@ extern const PROGMEM enum led_seg LED_HexFont[16];
  *  @ingroup Types  LED digit constants
  *  @brief LED dig
  */
-#if defined(ARDUINO)
-enum led_dig : uint8_t
+#if defined(ARDUINO) || LED_MAX_DIGITS > 8
+enum led_dig : led_digmask
 #else
 enum led_dig
 #endif
@@ -200,9 +375,119 @@ enum led_dig
     DIG_5=0x20,              /*!< 6th Digit */
     DIG_6=0x40,              /*!< 7th Digit */
     DIG_7=0x80,              /*!< 8th Digit */
-    MAX_DIGITS=8             /*!< Maximum number of digits */
+    MAX_DIGITS=LED_MAX_DIGITS /*!< Maximum number of digits */
 };
 
+/// All digits (for masks that gate digits on)
+#define LED_DIG_ALL         ((enum led_dig)(led_digmask) ~(led_digmask) 0)
+
+///
+/// Mask of the first digits
+/// @param  digits  Number of digits (0..MAX_DIGITS)
+/// @return mask    DIG_0..DIG_digits-1
+///
+inline enum led_dig LED_DigitMask(uint8_t digits)
+{
+    return (enum led_dig)((digits >= 8 * sizeof(led_digmask)) ? (led_digmask) ~(led_digmask) 0 :
+                          (led_digmask)(((led_digmask) 1 << digits) - 1));
+}
+
+///
+/// Compile-time copy of the ASCII glyphs.  Only read in constant
+/// expressions, so it never takes up flash or RAM.
+///
+template <typename T = void> struct LED_Glyphs
+{
+    static constexpr enum led_seg ascii[96] = { LED_ASCII_GLYPHS };
+};
+
+template <typename T> constexpr enum led_seg LED_Glyphs<T>::ascii[96];
+
+///
+/// Glyph of a character at compile time
+/// @param  c       ASCII character
+/// @return mask    Segments (LED_BLANK if not in the font)
+///
+constexpr enum led_seg LED_CharGlyph(char c)
+{
+    return (c >= ' ' && c < ' ' + 96) ? LED_Glyphs<>::ascii[c - ' '] : LED_BLANK;
+}
+
+///
+/// Number of characters making up the glyph at str: 2 if a '.' follows
+/// (folded into the decimal point), else 1
+///
+constexpr uint8_t LED_GlyphChars(const char* str)
+{
+    return (str[0] != 0 && str[0] != '.' && str[1] == '.') ? 2 : 1;
+}
+
+///
+/// Glyph n of a string at compile time, with decimal points folded into
+/// the previous glyph ("12.5" is 3 glyphs)
+/// @param  str     String literal
+/// @param  n       Glyph index
+/// @return mask    Segments (LED_BLANK past the end)
+///
+constexpr enum led_seg LED_TextGlyph(const char* str, uint8_t n)
+{
+    return (str[0] == 0) ? LED_BLANK :
+           (n > 0) ? LED_TextGlyph(str + LED_GlyphChars(str), (uint8_t)(n - 1)) :
+           (enum led_seg)(LED_CharGlyph(str[0]) | ((LED_GlyphChars(str) == 2) ? SEG_DP : 0));
+}
+
+///
+/// Number of glyphs in a string at compile time
+/// @param  str     String literal
+/// @return count   Number of glyphs
+///
+constexpr uint8_t LED_TextLength(const char* str)
+{
+    return (str[0] == 0) ? 0 : (uint8_t)(1 + LED_TextLength(str + LED_GlyphChars(str)));
+}
+
+/*!
+ *  @ingroup Macros
+ *  Define a display frame in flash from a string literal, translated at
+ *  compile time (blank padded to MAX_DIGITS glyphs).  Show it with
+ *  SevSeg::showRaw_P().  Precede with static inside a function.
+ *
+ *      LED_TEXT(msgBatt, "bAtt");
+ *      led7seg.showRaw_P(msgBatt);
+ *
+ *  @brief Compile-time text
+ *  @param name   Name of the array
+ *  @param str    String literal (at most MAX_DIGITS glyphs)
+ */
+#define LED_TEXT(name, str) \
+    const PROGMEM enum led_seg name[LED_TEXT_GLYPHS] = \
+    { \
+        LED_TEXT_ROWS(str) \
+    }; \
+    static_assert(LED_TextLength(str) <= MAX_DIGITS, "LED_TEXT: " str " is too long")
+
+/// Glyphs i..i+3 of a LED_TEXT() string
+#define LED_TEXT_ROW(str, i) \
+    LED_TextGlyph(str, i), LED_TextGlyph(str, i + 1), LED_TextGlyph(str, i + 2), LED_TextGlyph(str, i + 3)
+
+// LED_TEXT() array length: MAX_DIGITS rounded up to 4, 8, 16 or 32 glyphs
+#if LED_MAX_DIGITS <= 4
+    #define LED_TEXT_GLYPHS     4
+    #define LED_TEXT_ROWS(str)  LED_TEXT_ROW(str, 0)
+#elif LED_MAX_DIGITS <= 8
+    #define LED_TEXT_GLYPHS     8
+    #define LED_TEXT_ROWS(str)  LED_TEXT_ROW(str, 0), LED_TEXT_ROW(str, 4)
+#elif LED_MAX_DIGITS <= 16
+    #define LED_TEXT_GLYPHS     16
+    #define LED_TEXT_ROWS(str)  LED_TEXT_ROW(str, 0), LED_TEXT_ROW(str, 4), LED_TEXT_ROW(str, 8), \
+                                LED_TEXT_ROW(str, 12)
+#else
+    #define LED_TEXT_GLYPHS     32
+    #define LED_TEXT_ROWS(str)  LED_TEXT_ROW(str, 0), LED_TEXT_ROW(str, 4), LED_TEXT_ROW(str, 8), \
+                                LED_TEXT_ROW(str, 12), LED_TEXT_ROW(str, 16), LED_TEXT_ROW(str, 20), \
+                                LED_TEXT_ROW(str, 24), LED_TEXT_ROW(str, 28)
+#endif
+
 /*!
  *  @ingroup Types  LED configuration constants
  *  @brief LED config
@@ -220,7 +505,755 @@ enum led_config
     COMMON_ANODE=SEG_INVERT,          //!< Config for Common Anode LED display
     COMMON_CATHODE=DIG_INVERT         //!< Config for Common Cathode LED display
 };
+
+/*!
+ *  @ingroup Types  LED scan mode constants
+ *  @brief LED scan
+ */
+enum led_scan
+{
+    SCAN_NONE=0,             //!< No scan mode (port images out of date)
+    SCAN_DIGITS=1,           //!< One digit per slot (refreshDigits)
+    SCAN_SEGMENTS=2,         //!< One segment per slot (refreshSegments)
+    SCAN_AUTO=3              //!< Per frame, whichever of the two has fewer non-empty slots
+};
+
+/*!
+ *  @ingroup Types  LED marquee mode constants
+ *  @brief LED marquee
+ */
+enum led_marquee
+{
+    MARQUEE_OFF=0,           //!< No marquee running
+    MARQUEE_LOOP=1,          //!< Scroll in from the right, out to the left, repeat
+    MARQUEE_BOUNCE=2,        //!< Scroll left and right between the text ends
+    MARQUEE_ONCE=3           //!< Scroll in and out once, then stop (blank)
+};
+
+/*!
+ *  @ingroup Types  LED power state constants
+ *  @brief LED power state
+ */
+enum led_power
+{
+    POWER_ON=0,              //!< Normal scan rate
+    POWER_LOW=1,             //!< Content unchanged: low scan rate
+    POWER_BLANK=2            //!< Content unchanged for longer: display off
+};
+
+/*!
+ *  @ingroup Types  Key event constants.  Events are the key number
+ *  (digit line + MAX_DIGITS * return pin index) for a press, or'ed with
+ *  KEY_UP for a release.
+ *  @brief LED key event
+ */
+enum led_key
+{
+    KEY_UP=0x80,             //!< Release flag
+    KEY_NONE=0xFF            //!< No key event queued
+};
+
+/*!
+ *  @ingroup Types  Built-in animation constants
+ *  @brief LED animation
+ */
+enum led_anim
+{
+    ANIM_SEGMENT_WALK=0,     //!< Light A, AB, .. A-G+DP on each digit in turn
+    ANIM_ALL_ON=1,           //!< All segments on (lamp test)
+    ANIM_SPINNER=2           //!< One outer segment circling on every digit
+};
+
+/*!
+ *  @ingroup Types
+ *  @brief Refresh statistics (LED_STATS)
+ */
+struct led_stats
+{
+    unsigned long frames;           //!< Completed frames
+    unsigned long slots;            //!< Scan slots shown
+    unsigned long late;             //!< Slots more than 1.5 nominal intervals after the previous one
+    unsigned long missed;           //!< Nominal slot intervals lost in late slots
+    unsigned long nominal;          //!< Nominal slot interval in microseconds
+    unsigned long minInterval;      //!< Shortest interval between slots in microseconds
+    unsigned long maxInterval;      //!< Longest interval between slots in microseconds
+    unsigned long maxMicros;        //!< Longest refresh in microseconds (micros() steps, 4 us at 16 MHz)
+};
+
+/// Scan slots per frame at most (digits or segments)
+#define LED_SLOTS           ((LED_MAX_DIGITS > SEGMENTS) ? LED_MAX_DIGITS : SEGMENTS)
+
+/*!
+ *  @ingroup Types
+ *  @brief LED display page: segment buffer plus the output state derived from it
+ */
+struct led_page
+{
+    enum led_seg buf[MAX_DIGITS];               //!< Buffer of segments to display
+    enum led_dig planes[SEGMENTS];              //!< Digits showing each segment (buf transposed)
+    enum led_dig digits;                        //!< Non-empty digit slots
+    uint8_t segments;                           //!< Non-empty segment slots
+    uint8_t scanMode;                           //!< Scan mode with fewer non-empty slots
+};
+
+#if LED_PORT_IO
+/*!
+ *  @ingroup Types
+ *  @brief Port images of a LED display page (SevSeg direct port output)
+ */
+struct led_images
+{
+    uint8_t mode;                               //!< Scan mode the images were rendered for
+    uint8_t image[LED_SLOTS][LED_MAX_PORTS];    //!< Port images per scan slot
+};
+#endif
+
+///
+/// Output backend for SevSeg (see LEDDrivers.h).  Multiplexed outputs such
+/// as shift registers implement slot(), which SevSeg calls once per scan
+/// slot.  Controllers that multiplex the display themselves implement
+/// frame(), which SevSeg calls once per commit().
+/// @brief LED output backend
+///
+class LEDOutput
+{
+public:
+    ///
+    /// Initialize the output hardware
+    /// @param  digits  Number of digits
+    ///
+    virtual void begin(uint8_t digits) = 0;
+    ///
+    /// Show one scan slot
+    /// @param  seg     Segments to turn on (SEG_A..SEG_DP)
+    /// @param  dig     Digits to turn on (DIG_0..DIG_n-1)
+    ///
+    virtual void slot(enum led_seg seg, enum led_dig dig)
+    {
+        (void) seg;
+        (void) dig;
+    }
+    ///
+    /// Show a committed frame
+    /// @param  buf     Buffer of segments (digit 0 first)
+    /// @param  digits  Number of digits
+    ///
+    virtual void frame(const enum led_seg* buf, uint8_t digits)
+    {
+        (void) buf;
+        (void) digits;
+    }
+    ///
+    /// Set the display brightness
+    /// @param  level   Brightness 0 (off) .. LED_BRIGHT_MAX (full)
+    ///
+    virtual void brightness(uint8_t level)
+    {
+        (void) level;
+    }
+};
     
+///
+/// Display state shared by SevSeg and SevSegT: the pages and show*()
+/// drawing, the refresh timer and the optional marquee and animation
+/// player (LED_PLAYER), brightness (LED_BRIGHT), blink (LED_BLINK) and
+/// power save (LED_POWER).  It holds no pins and has no virtual methods:
+/// SevSegCore calls the output hooks of the display class directly.
+/// @brief LED 7-Segment library base
+///
+class SevSegBase
+{
+public:
+    // Constructor
+    SevSegBase();
+protected:
+    uint8_t m_digits;              //!< Number of digits (e.g. sizeof(m_digitPin)
+    uint8_t m_index;               //!< Index of digit to multiplex
+    uint8_t m_timerMode;           //!< Scan mode when refreshed by timer (SCAN_NONE=polled)
+    uint8_t m_newFrame;            //!< The last nextSlot() started a new frame
+    unsigned long m_last;          //!< Timestamp of last refresh/update
+
+    struct led_page m_page[2];     //!< Front (displayed) and back (drawn) pages
+    volatile uint8_t m_front;      //!< Index of the page being displayed
+    volatile uint8_t m_flip;       //!< Page flip pending at the next frame boundary
+    uint8_t m_stale;               //!< Back page must be refreshed from the front page
+    uint8_t m_autoCommit;          //!< Commit after every show*() call
+    uint8_t m_skip;                //!< Scan only non-empty slots
+    uint8_t m_scanMode;            //!< Scan mode of the current frame (SCAN_AUTO)
+
+#if LED_STATS
+    struct led_stats m_stats;      //!< Refresh statistics
+    unsigned long m_statLast;      //!< Time of the last slot in microseconds
+
+    ///
+    /// Record the start of a scan slot
+    /// @return start   Time in microseconds
+    ///
+    unsigned long statBegin(void)
+    {
+        const unsigned long now = micros();
+        if (m_stats.slots)
+        {
+            const unsigned long interval = now - m_statLast;
+            const unsigned long nominal = m_stats.nominal;
+            if (interval < m_stats.minInterval)
+                m_stats.minInterval = interval;
+            if (interval > m_stats.maxInterval)
+                m_stats.maxInterval = interval;
+            if (interval > nominal + nominal / 2)
+            {
+                ++m_stats.late;
+                m_stats.missed += (interval + nominal / 2) / nominal - 1;
+            }
+        }
+        m_statLast = now;
+        ++m_stats.slots;
+        return now;
+    }
+
+    ///
+    /// Record the end of a scan slot
+    /// @param  start   Time returned by statBegin()
+    ///
+    void statEnd(unsigned long start)
+    {
+        const unsigned long busy = micros() - start;
+        if (busy > m_stats.maxMicros)
+            m_stats.maxMicros = busy;
+    }
+#endif
+
+#if LED_PLAYER
+    volatile uint8_t m_playMode;   //!< Marquee/animation mode (MARQUEE_OFF = not running)
+    uint16_t m_playStep;           //!< Milliseconds until the next step
+    unsigned long m_playLast;      //!< Timestamp of last step
+    void (*m_playRender)(SevSegBase* led); //!< Step handler (stepMarquee or stepAnimation)
+    volatile uint8_t m_playDue;    //!< Step drawn into the back page, commit left to update()
+    const char* m_mqText;          //!< Marquee text (RAM or flash)
+    uint8_t m_mqFlash;             //!< Marquee text is in flash (PROGMEM)
+    int8_t m_mqDir;                //!< Marquee step direction (+1/-1)
+    int16_t m_mqPos;               //!< Glyph index shown on the leftmost digit
+    int16_t m_mqLen;               //!< Marquee length in glyphs
+    const enum led_seg* m_anFrames; //!< Animation frames in flash (0 = built-in m_anKind)
+    const uint16_t* m_anTimes;     //!< Animation frame durations in flash (0 = all m_anStep)
+    uint16_t m_anStep;             //!< Animation milliseconds per frame (without m_anTimes)
+    uint8_t m_anKind;              //!< Built-in animation (enum led_anim)
+    uint8_t m_anCount;             //!< Animation length in frames
+    uint8_t m_anFrame;             //!< Animation frame shown next
+    int8_t m_anDir;                //!< Animation step direction (+1/-1)
+    void (*m_anDone)(SevSegBase* led); //!< Called when a MARQUEE_ONCE animation ends
+    volatile uint8_t m_anEnded;    //!< Animation ended, m_anDone not called yet
+#endif
+    enum led_seg* m_buf;           //!< Buffer of segments being drawn (back page)
+    enum led_dig m_dirty;          //!< Back page digits changed since its planes/images were built
+    uint8_t m_changed;             //!< Back page drawn since the last commit
+
+#if LED_BRIGHT
+    enum led_dig m_bright[LED_BRIGHT_BITS]; //!< Digits with each brightness bit set
+    uint8_t m_bcmBit;              //!< Brightness bit of the current frame
+    uint8_t m_dimmed;              //!< Brightness modulation active
+#endif
+    enum led_dig m_gate;           //!< Digits allowed on in the current frame (DIG_NONE = blanked)
+#if LED_BLINK
+    enum led_dig m_blink;          //!< Blinking digits
+    volatile enum led_dig m_blinkOff; //!< Digits showing their alternate content (blink phase)
+    uint16_t m_blinkStep;          //!< Milliseconds per blink phase
+    unsigned long m_blinkLast;     //!< Timestamp of the last blink phase change
+    enum led_seg m_alt[MAX_DIGITS]; //!< Alternate content shown in the off phase
+    enum led_dig m_altPlanes[SEGMENTS]; //!< Blinking digits showing each alternate segment
+    enum led_dig m_altDigits;      //!< Blinking digits with alternate content
+    uint8_t m_altSegments;         //!< Segments of the alternate content of the blinking digits
+
+    void stopBlink(void);
+    void startBlink(enum led_dig mask, uint16_t msec);
+    void updateBlink(enum led_dig mask);
+
+    ///
+    /// Switch the blink phase when it is due.  Called next to tickPlayer().
+    /// @param  now     Current time in milliseconds
+    ///
+    void tickBlink(unsigned long now)
+    {
+        if (m_blink && (now - m_blinkLast) >= m_blinkStep)
+        {
+            m_blinkLast = now;
+            m_blinkOff = m_blinkOff ? DIG_NONE : m_blink;
+        }
+    }
+#endif
+
+    uint8_t buildPlanes(struct led_page* page);
+    void activeSlots(struct led_page* page);
+    uint8_t buildPage(struct led_page* page);
+    void flipPage(void);
+#if LED_BRIGHT
+    void setBrightBits(enum led_dig digits, uint8_t level);
+    boolean brightDimmed(void);
+#endif
+    void updateGate(void);
+    void beginUpdate(void);
+
+    ///
+    /// Finish drawing into the back page
+    ///
+    void endUpdate(void)
+    {
+        if (m_autoCommit)
+            m_commit(this);
+    }
+
+    ///
+    /// Rebuild the output state of the brightness levels.  Output hook
+    /// (see SevSegCore): the display class may hide it.
+    ///
+    void updateBrightness(void)
+    {
+        updateGate();
+    }
+
+    ///
+    /// Update the output state derived from a committed page (port images,
+    /// controller frame).  Output hook called by publish(), never from the
+    /// timer interrupt.
+    /// @param  page    Committed page
+    /// @param  planes  Bit mask of the changed planes (from buildPlanes())
+    ///
+    void updatePage(struct led_page* page, uint8_t planes)
+    {
+        (void) page;
+        (void) planes;
+    }
+
+    ///
+    /// Render the output state of the displayed page for a timer scan
+    /// mode.  Output hook called when the timer is attached.
+    /// @param  page    Displayed page
+    /// @param  mode    Timer scan mode
+    ///
+    void renderPage(struct led_page* page, enum led_scan mode)
+    {
+        (void) page;
+        (void) mode;
+    }
+
+    ///
+    /// Draw one digit into the back page, marking it dirty if it changed
+    /// @param  digit   Digit index (0 = leftmost)
+    /// @param  mask    Segments to show
+    ///
+    void drawDigit(uint8_t digit, enum led_seg mask)
+    {
+        if (m_buf[digit] != mask)
+        {
+            m_buf[digit] = mask;
+            m_dirty = (enum led_dig)(m_dirty | (DIG_0 << digit));
+            m_changed = true;
+        }
+    }
+#if LED_PLAYER
+    void startMarquee(const char* str, uint8_t flash, uint16_t msec, enum led_marquee mode);
+    void renderMarquee(void);
+    static void stepMarquee(SevSegBase* led);
+    void startAnimation(const enum led_seg* frames, uint8_t count, const uint16_t* times,
+                        uint16_t msec, enum led_marquee mode);
+    enum led_seg animationGlyph(uint8_t frame, uint8_t digit);
+    void renderAnimation(void);
+    static void stepAnimation(SevSegBase* led);
+    void playEnded(void);
+
+    ///
+    /// Draw the next marquee or animation step when it is due.  Called
+    /// from the refresh methods and, while the timer is attached, once per
+    /// frame from the timer interrupt.  update() commits the step; the
+    /// player waits until it has.
+    /// @param  now     Current time in milliseconds
+    ///
+    void tickPlayer(unsigned long now)
+    {
+        if (m_playMode != MARQUEE_OFF && (now - m_playLast) >= m_playStep && !m_flip && !m_playDue)
+        {
+            m_playLast = now;
+            m_playRender(this);
+        }
+    }
+#endif
+
+    static SevSegBase* s_timer[LED_MAX_DISPLAYS]; //!< Displays refreshed by the timer interrupt
+    static uint8_t s_timers;       //!< Number of displays in s_timer
+    static uint8_t s_phase;        //!< Tick within the interleave cycle
+    static uint8_t s_phases;       //!< Ticks per interleave cycle
+    static uint16_t s_hz;          //!< Slot rate of each display in Hz
+    void (*m_tick)(SevSegBase* led); //!< Timer interrupt handler for this display
+    void (*m_commit)(SevSegBase* led); //!< commit() of the display class (set by SevSegCore)
+    void (*m_update)(SevSegBase* led); //!< update() of the display class (set by SevSegCore)
+
+    boolean addTimer(enum led_scan mode, uint16_t hz, void (*tick)(SevSegBase* led));
+    boolean removeTimer(void);
+    static boolean restartTimer(uint16_t hz);
+#if LED_POWER
+    static uint16_t s_lowHz;       //!< Slot rate in Hz while all displays are idle
+    static uint8_t s_power;        //!< Timer power state (lowest of the displays)
+    volatile uint8_t m_power;      //!< Power state (enum led_power)
+    volatile uint8_t m_active;     //!< Content committed since the last frame
+    volatile uint8_t m_powerDue;   //!< Power state changed in the interrupt, not applied yet
+    uint16_t m_lowAfter;           //!< Seconds unchanged before POWER_LOW (0 = never)
+    uint16_t m_blankAfter;         //!< Seconds unchanged before POWER_BLANK (0 = never)
+    unsigned long m_idleSince;     //!< Time of the last content change seen by the timer
+
+    static void powerRate(void);
+    void tickPower(unsigned long now);
+    void wake(void);
+    void applyPower(void);
+#endif
+
+    ///
+    /// Find the next non-empty slot of a page
+    /// @param  page    Page to display
+    /// @param  mode    SCAN_DIGITS or SCAN_SEGMENTS
+    /// @param  index   First slot to test
+    /// @return index   Non-empty slot, or LED_SLOTS if none is left
+    ///
+    uint8_t nextActive(const struct led_page* page, uint8_t mode, uint8_t index)
+    {
+#if LED_MAX_DIGITS >= 32
+        // Shifting a 32-bit mask by 32 is undefined
+        if (index >= 32)
+            return LED_SLOTS;
+#endif
+#if LED_BLINK
+        // Alternate content may light slots that are empty on the page
+        led_digmask active = (led_digmask)(((mode == SCAN_DIGITS) ? (led_digmask)(page->digits | m_altDigits) :
+                                                                    (led_digmask)(page->segments | m_altSegments)) >> index);
+#else
+        led_digmask active = (led_digmask)(((mode == SCAN_DIGITS) ? (led_digmask) page->digits : page->segments) >> index);
+#endif
+        if (!active)
+            return LED_SLOTS;
+        while (!(active & 0x01))
+        {
+            active >>= 1;
+            ++index;
+        }
+        return index;
+    }
+
+    ///
+    /// Advance m_index to the next slot, showing a committed page at the
+    /// frame boundary.  Empty slots are passed over with setSkipEmpty() or
+    /// SCAN_AUTO.
+    /// @param  mode    SCAN_DIGITS, SCAN_SEGMENTS or SCAN_AUTO
+    /// @return page    Page to display
+    ///
+    struct led_page* nextSlot(uint8_t mode)
+    {
+        const boolean adapt = (mode == SCAN_AUTO);
+        const boolean skip = m_skip || adapt;
+        if (adapt)
+            mode = m_scanMode;
+        struct led_page* page = &m_page[m_front];
+        uint8_t index = m_index + 1;
+        if (skip)
+            index = nextActive(page, mode, index);
+        if (index >= ((mode == SCAN_DIGITS) ? m_digits : (uint8_t) SEGMENTS))
+        {
+            index = 0;
+            m_newFrame = true;
+#if LED_STATS
+            ++m_stats.frames;
+#endif
+            if (m_flip)
+            {
+                m_front ^= 1;
+                m_flip = 0;
+            }
+#if LED_BRIGHT
+            if (m_dimmed)
+            {
+                // Next brightness bit: gate digits for this frame
+                uint8_t bit = m_bcmBit + 1;
+                if (bit >= LED_BRIGHT_BITS)
+                    bit = 0;
+                m_bcmBit = bit;
+                m_gate = m_bright[bit];
+            }
+#endif
+            page = &m_page[m_front];
+            if (skip)
+            {
+                if (adapt)
+                    m_scanMode = mode = page->scanMode;
+                index = nextActive(page, mode, 0);
+                if (index >= LED_SLOTS)
+                    index = 0;
+            }
+        }
+        m_index = index;
+        return page;
+    }
+
+#if LED_BRIGHT
+    ///
+    /// Brightness bit of the slot the next nextSlot() call will show (the
+    /// next bit when that slot starts a frame).  Lets the timer interrupt
+    /// set the slot length before drawing the slot.
+    /// @return bit     0..LED_BRIGHT_BITS-1
+    ///
+    uint8_t slotBit(void)
+    {
+        uint8_t mode = m_timerMode;
+        uint8_t index = m_index + 1;
+        if (mode == SCAN_AUTO)
+            index = nextActive(&m_page[m_front], mode = m_scanMode, index);
+        else if (m_skip)
+            index = nextActive(&m_page[m_front], mode, index);
+        if (index < ((mode == SCAN_DIGITS) ? m_digits : (uint8_t) SEGMENTS))
+            return m_bcmBit;
+        return (uint8_t)((m_bcmBit + 1 < LED_BRIGHT_BITS) ? m_bcmBit + 1 : 0);
+    }
+#endif
+
+public:
+    void setSkipEmpty(boolean on);
+    static void timerTick(void);
+#if LED_POWER
+    void setPowerSave(uint16_t lowSec, uint16_t blankSec, uint16_t lowHz = 250);
+    enum led_power powerState(void);
+#endif
+    static void idle(void);
+    void showHex(unsigned long num);
+    void showNumber(led_number num, uint8_t dp, enum led_seg fill = SEG_NONE);
+    void showDecimal(led_signed i, uint8_t dp);
+    void showText(const char* str);
+    void showRaw(const enum led_seg* buf);
+    void showRaw_P(const enum led_seg* buf);
+    void setDigit(uint8_t index, enum led_seg mask);
+    void setRange(uint8_t index, const enum led_seg* buf, uint8_t count);
+
+    /// Number of digits (as passed to begin())
+    uint8_t digitCount(void) const
+    {
+        return m_digits;
+    }
+#if LED_STATS
+    void getStats(struct led_stats* stats);
+    void resetStats(void);
+#if defined(ARDUINO)
+    void printStats(Print& out = Serial);
+#endif
+#endif
+#if LED_PLAYER
+    void showMarquee(const char* str, uint16_t msec, enum led_marquee mode = MARQUEE_LOOP);
+    void showMarquee(const __FlashStringHelper* str, uint16_t msec, enum led_marquee mode = MARQUEE_LOOP);
+    boolean marqueeBusy(void);
+    void showAnimation(const enum led_seg* frames, uint8_t count, const uint16_t* msec,
+                       enum led_marquee mode = MARQUEE_LOOP);
+    void showAnimation(const enum led_seg* frames, uint8_t count, uint16_t msec,
+                       enum led_marquee mode = MARQUEE_LOOP);
+    void showAnimation(enum led_anim anim, uint16_t msec, enum led_marquee mode = MARQUEE_LOOP);
+    boolean animationBusy(void);
+    void setAnimationDone(void (*done)(SevSegBase* led));
+#endif
+    void setAutoCommit(boolean on);
+
+    ///
+    /// Commit the back page (see SevSegCore::commit())
+    ///
+    void commit(void)
+    {
+        m_commit(this);
+    }
+
+    ///
+    /// Finish what the timer interrupt leaves to the main loop (see
+    /// SevSegCore::update())
+    ///
+    void update(void)
+    {
+        m_update(this);
+    }
+};
+
+///
+/// Calls the output hooks of a display class without virtual methods.
+/// Display derives from SevSegCore<Display>, may hide the SevSegBase
+/// hooks updatePage(), renderPage(), updateBrightness(), updateBlink()
+/// and applyPower(), and must define blank() to turn every digit off.
+/// The show*() methods reach commit() through m_commit and idle() reaches
+/// update() through m_update, the way the timer interrupt reaches the
+/// scan through m_tick.
+/// @brief LED 7-Segment library output hooks
+/// @tparam Display SevSeg or SevSegT
+///
+template <class Display>
+class SevSegCore : public SevSegBase
+{
+protected:
+    // Constructor
+    SevSegCore()
+    {
+        m_commit = commitDisplay;
+        m_update = updateDisplay;
+    }
+
+    /// The display class
+    Display* display(void)
+    {
+        return static_cast<Display*>(this);
+    }
+
+    static void commitDisplay(SevSegBase* led)
+    {
+        static_cast<SevSegCore*>(led)->commit();
+    }
+
+    static void updateDisplay(SevSegBase* led)
+    {
+        static_cast<SevSegCore*>(led)->update();
+    }
+
+    ///
+    /// Commit the back page (no page flip may be pending).  Only the
+    /// planes and output state of dirty digits are rebuilt.
+    ///
+    void publish(void)
+    {
+        struct led_page* page = &m_page[m_front ^ 1];
+        display()->updatePage(page, buildPage(page));
+        flipPage();
+    }
+
+    ///
+    /// Start the refresh timer with a given per-slot handler
+    /// @param  mode    SCAN_DIGITS, SCAN_SEGMENTS or SCAN_AUTO
+    /// @param  hz      Scan rate in slots per second
+    /// @param  tick    Handler called from the timer interrupt
+    /// @return true    if the timer is running
+    ///
+    boolean startTimer(enum led_scan mode, uint16_t hz, void (*tick)(SevSegBase* led))
+    {
+        detachTimer();
+        if (mode == SCAN_NONE || s_timers >= LED_MAX_DISPLAYS)
+            return false;
+        struct led_page* page = &m_page[m_front];
+        display()->renderPage(page, (mode == SCAN_AUTO) ? (enum led_scan) page->scanMode : mode);
+        return addTimer(mode, hz, tick);
+    }
+
+public:
+    ///
+    /// Show the back page.  When refreshed by the timer interrupt the pages
+    /// are swapped at the next frame boundary, so a frame never shows a
+    /// partially drawn page; otherwise they are swapped immediately.  Does
+    /// nothing if the back page has not changed since the last commit.
+    ///
+    void commit(void)
+    {
+        beginUpdate();
+        if (m_changed)
+            publish();
+#if LED_POWER
+        display()->applyPower();
+#endif
+    }
+
+    ///
+    /// Finish what the timer interrupt leaves to the main loop: commit the
+    /// marquee or animation step it drew, apply power save changes and run
+    /// the animation done function if an animation ended.  Call this from
+    /// loop() while the timer refreshes the display (idle() and the
+    /// refresh methods call it).
+    ///
+    void update(void)
+    {
+#if LED_PLAYER
+        if (m_playDue)
+        {
+            // No page flip is pending: the player does not draw while one is
+            publish();
+            m_playDue = false;
+        }
+#endif
+#if LED_POWER
+        display()->applyPower();
+#endif
+#if LED_PLAYER
+        playEnded();
+#endif
+    }
+
+    ///
+    /// Stop refreshing from the timer interrupt and turn all digits off
+    ///
+    void detachTimer(void)
+    {
+        if (removeTimer())
+            display()->blank();
+    }
+
+#if LED_BRIGHT
+    ///
+    /// Set the brightness of all digits.  Brightness is modulated by the
+    /// timer interrupt (see attachTimer()); polled refresh is always at
+    /// full brightness.
+    /// @param  level   Brightness 0 (off) .. LED_BRIGHT_MAX (full)
+    ///
+    void setBrightness(uint8_t level)
+    {
+        setBrightBits(LED_DIG_ALL, level);
+        display()->updateBrightness();
+    }
+
+    ///
+    /// Set the brightness of one digit
+    /// @param  digit   Digit index (0 = leftmost)
+    /// @param  level   Brightness 0 (off) .. LED_BRIGHT_MAX (full)
+    ///
+    void setDigitBrightness(uint8_t digit, uint8_t level)
+    {
+        if (digit >= MAX_DIGITS)
+            return;
+        setBrightBits((enum led_dig)(DIG_0 << digit), level);
+        display()->updateBrightness();
+    }
+#endif
+
+#if LED_BLINK
+    ///
+    /// Blink digits from the refresh without redrawing them: in the off
+    /// phase a blinking digit shows its alternate content (blank unless
+    /// set with setBlinkContent()).  Each call restarts the blink in the on
+    /// phase, so calling it while a value is being adjusted keeps the
+    /// value readable.  Works with pins and multiplexed backends (slot()),
+    /// not with LED controllers that refresh the display themselves.
+    /// @param  mask    Digits to blink (DIG_NONE = stop blinking)
+    /// @param  msec    Milliseconds per phase (on and off)
+    ///
+    void setBlink(enum led_dig mask, uint16_t msec = 500)
+    {
+        // Stop blinking while the tables are rebuilt
+        stopBlink();
+        display()->updateBlink(mask);
+        startBlink(mask, msec);
+    }
+
+    ///
+    /// Set the alternate content of a blinking digit, e.g. SEG_DP to leave
+    /// the decimal point lit or a dash in place of a blank digit.
+    /// @param  digit   Digit index (0 = leftmost)
+    /// @param  mask    Segments shown in the off phase (SEG_NONE = blank)
+    ///
+    void setBlinkContent(uint8_t digit, enum led_seg mask)
+    {
+        if (digit >= MAX_DIGITS)
+            return;
+        m_alt[digit] = mask;
+        // Rebuild the tables for the current blink digits
+        setBlink(m_blink, m_blinkStep);
+    }
+#endif
+};
+
+
 ///
 /// LED 7-Segment Display Driver library for Arduino
 ///
@@ -244,33 +1277,411 @@ enum led_config
 /// any pin (approx 100mA see datasheet for details) use a PNP or NPN 
 /// transistor to prevent damage to the ATMega microprocessor.
 ///
+/// SCAN_AUTO switches between digit and segment scan from frame to frame,
+/// so only use it when both the segment and the digit lines are current
+/// limited (or the backend drives constant current).
+///
 /// @brief LED 7-Segment library
 ///
-class SevSeg
+class SevSeg : public SevSegCore<SevSeg>
 {
+    friend class SevSegCore<SevSeg>;
 public:
     // Constructor
     SevSeg();
 protected:
     uint8_t m_config;              //!< Config byte: bit 0=SEG_INVERT, bit 1=DIG_INVERT
-    uint8_t m_digits;              //!< Number of digits (e.g. sizeof(m_digitPin)
-    uint8_t m_index;               //!< Index of digit to multiplex
-    unsigned long m_last;          //!< Timestamp of last refresh/update
-    
-    enum led_seg m_buf[MAX_DIGITS]; //!< Buffer of segments to display
     const uint8_t* m_pins;         //!< Digit pin array
+    LEDOutput* m_out;              //!< Output backend (0 = pins)
+    enum led_seg m_segShadow;      //!< Segments last set by setSegments()
+    enum led_dig m_digShadow;      //!< Digits last set by setDigits()
+
+#if LED_PORT_IO
+    uint8_t m_ports;                            //!< Number of ports used (0=use digitalWrite)
+    uint8_t m_shadow[LED_MAX_PORTS];            //!< Port bits last written (LED pins only)
+    led_port* m_portReg[LED_MAX_PORTS];         //!< Output port registers
+    uint8_t m_segPort[LED_MAX_PORTS];           //!< Segment pin bits per port
+    uint8_t m_digPort[LED_MAX_PORTS];           //!< Digit pin bits per port
+    uint8_t m_digOff[LED_MAX_PORTS];            //!< Port image with all digits off
+    uint8_t m_pinMap[SEGMENTS + MAX_DIGITS];    //!< Pin to (port << 3 | bit)
+#if LED_BRIGHT
+    uint8_t m_brightX[LED_BRIGHT_BITS][LED_MAX_PORTS]; //!< Digit gate images per brightness bit
+#endif
+    struct led_images m_images[2];              //!< Port images of m_page[0] and m_page[1]
+#if LED_BLINK
+    uint8_t m_blinkX[LED_MAX_PORTS];            //!< Digit pin bits of the blinking digits
+    uint8_t m_altX[SEGMENTS][LED_MAX_PORTS];    //!< Blinking digit pin levels per segment slot
+    uint8_t m_altImage[MAX_DIGITS][LED_MAX_PORTS]; //!< Port images of the alternate digit slots
+#endif
+
+    ///
+    /// Port images of a page
+    /// @param  page    m_page[0] or m_page[1]
+    /// @return images  Its entry of m_images
+    ///
+    struct led_images* imagesOf(const struct led_page* page)
+    {
+        return &m_images[(page == &m_page[0]) ? 0 : 1];
+    }
+
+    void mapPins(void);
+    void buildImage(uint8_t* image, enum led_seg seg, enum led_dig dig);
+    void writePorts(const uint8_t* image, const uint8_t* mask);
+    void renderImages(struct led_page* page, enum led_scan mode);
+    void updateImages(struct led_page* page, uint8_t planes);
+    void outputImage(const uint8_t* image);
+#if LED_BRIGHT
+    void updateBrightness(void);
+#endif
+    void renderPage(struct led_page* page, enum led_scan mode);
+#if LED_BLINK
+    void updateBlink(enum led_dig mask);
+#endif
+#endif
+
+    void slotDigits(struct led_page* page);
+    void slotSegments(struct led_page* page);
+    void updatePage(struct led_page* page, uint8_t planes);
+#if LED_POWER
+    void applyPower(void);
+#endif
+    void blank(void);
+    static void tickDigits(SevSegBase* led);
+    static void tickSegments(SevSegBase* led);
+    static void tickAuto(SevSegBase* led);
+
+#if LED_KEYS
+    /// Key scan phase (m_keyPhase)
+    enum { KEY_IDLE = 0, KEY_DRIVE = 1, KEY_SAMPLE = 2 };
+
+    uint8_t m_keyPins[LED_KEY_RETURNS]; //!< Key return pins
+    uint8_t m_keyReturns;          //!< Number of return pins
+    uint8_t m_keyLevel;            //!< Return pin level of a pressed key (digit on level)
+    enum led_dig m_keyLines;       //!< Digit lines driving keys (DIG_NONE = no keypad)
+    uint8_t m_keyLine;             //!< Digit line of the current key slot
+    volatile uint8_t m_keyPhase;   //!< Key slot due (KEY_DRIVE) or to be sampled (KEY_SAMPLE)
+    uint8_t m_keyStep;             //!< Milliseconds between key slots
+    unsigned long m_keyLast;       //!< Timestamp of the last key slot
+    led_digmask m_keyRaw[LED_KEY_RETURNS]; //!< Lines with the key down in their last sample, per return pin
+    volatile led_digmask m_keyDown[LED_KEY_RETURNS]; //!< Lines with the key down (debounced), per return pin
+    uint8_t m_keyQueue[LED_KEY_QUEUE]; //!< Key events (enum led_key)
+    volatile uint8_t m_keyHead;    //!< Next queue entry written by the refresh
+    volatile uint8_t m_keyTail;    //!< Next queue entry read by readKey()
+
+    boolean keySlot(void);
+    void keySample(void);
+
+    ///
+    /// Make a key slot due every m_keyStep milliseconds.  Called next to
+    /// tickPlayer().
+    /// @param  now     Current time in milliseconds
+    ///
+    void tickKeys(unsigned long now)
+    {
+        if (m_keyLines && m_keyPhase == KEY_IDLE && (now - m_keyLast) >= m_keyStep)
+        {
+            m_keyLast = now;
+            m_keyPhase = KEY_DRIVE;
+        }
+    }
+
+    ///
+    /// Run the due key slot step in place of a display slot, or make the
+    /// next key slot due.  Called by the timer handlers.
+    /// @return used    true if the key slot took the place of a display slot
+    ///
+    boolean keyTick(void)
+    {
+        if (m_keyPhase != KEY_IDLE)
+            return keySlot();
+        if (m_keyLines)
+            tickKeys(millis());
+        return false;
+    }
+#endif
 
 public:
     void begin(enum led_config conf, uint8_t digits, const uint8_t* pin);
+    void begin(LEDOutput* out, uint8_t digits);
     void setSegments(enum led_seg mask);
     void setDigits(enum led_dig mask);
     void refreshDigits(void);
     void refreshSegments(void);
-    void showHex(unsigned long num);
-    void showNumber(unsigned long num, uint8_t dp, enum led_seg fill = SEG_NONE);
-    void showDecimal(signed long i, uint8_t dp);
-    void showText(const char* str);
-    void showRaw(const enum led_seg* buf);
+    void scanDigits(void);
+    void scanSegments(void);
+    void scanAuto(void);
+    boolean attachTimer(enum led_scan mode, uint16_t hz);
+    void setBrightness(uint8_t level);
+#if LED_KEYS
+    void setKeypad(const uint8_t* pins, uint8_t count, enum led_dig lines, uint8_t msec = 8);
+    uint8_t readKey(void);
+    boolean keyDown(uint8_t key);
+#endif
+};
+
+/// Pin-to-port mapping known at compile time (Arduino Uno/Nano/Pro Mini
+/// and the host build) so SevSegT can be used.
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega168__) || !defined(ARDUINO)
+#define LED_STATIC_PINS     1
+
+///
+/// Port (PB, PC or PD) of a digital pin
+/// @param  pin     Digital pin number (0-19)
+/// @return port    PB, PC, PD or NOT_A_PIN
+///
+constexpr uint8_t LED_PinPort(uint8_t pin)
+{
+    return (pin < 8) ? PD : (pin < 14) ? PB : (pin < 20) ? PC : NOT_A_PIN;
+}
+
+///
+/// Port bit mask of a digital pin
+/// @param  pin     Digital pin number (0-19)
+/// @return mask    Bit mask within LED_PinPort(pin)
+///
+constexpr uint8_t LED_PinBit(uint8_t pin)
+{
+    return (uint8_t)((pin < 8) ? (1 << pin) : (pin < 14) ? (1 << (pin - 8)) :
+                     (pin < 20) ? (1 << (pin - 14)) : 0);
+}
+
+///
+/// Output register of a port
+/// @param  port    PB, PC or PD
+/// @return reg     PORTB, PORTC or PORTD
+///
+inline led_port& LED_PortReg(uint8_t port)
+{
+    return (port == PB) ? PORTB : (port == PC) ? PORTC : PORTD;
+}
+
+///
+/// Compile-time pin list.  bits<Port>(sel) returns the bits of Port
+/// driven by the pins selected in sel (bit 0 = first pin).  It folds to a
+/// constant for constant sel and to a few bit tests otherwise.
+///
+template <uint8_t... Pins> struct LED_Pins;
+
+template <> struct LED_Pins<>
+{
+    template <uint8_t Port> static constexpr uint8_t bits(uint16_t)
+    {
+        return 0;
+    }
 };
 
+template <uint8_t Pin, uint8_t... Rest> struct LED_Pins<Pin, Rest...>
+{
+    template <uint8_t Port> static constexpr uint8_t bits(uint16_t sel)
+    {
+        return (uint8_t)(((LED_PinPort(Pin) == Port && (sel & 1)) ? LED_PinBit(Pin) : 0) |
+                         LED_Pins<Rest...>::template bits<Port>((uint16_t)(sel >> 1)));
+    }
+};
+
+///
+/// SevSeg specialized at compile time for one board wiring.  Polarity,
+/// digit count, port registers and port masks are all constants, so a
+/// refresh step is a fixed sequence of masked writes with no pin table
+/// or configuration lookups.  The show*() methods are shared with SevSeg
+/// through SevSegBase, without SevSeg's pin tables and port images; the
+/// only output hook it has is blank().
+///
+///     SevSegT<COMMON_CATHODE, 4, 5, 9, A2, A4, A5, 6, A1, A3, 4, 7, 8, A0> led7seg;
+///
+/// @brief LED 7-Segment library (compile-time pins)
+/// @tparam Conf    COMMON_ANODE or COMMON_CATHODE
+/// @tparam Digits  Number of digits
+/// @tparam Pins    Segment pins A-G,DP followed by the digit pins
+///
+template <enum led_config Conf, uint8_t Digits, uint8_t... Pins>
+class SevSegT : public SevSegCore<SevSegT<Conf, Digits, Pins...> >
+{
+    friend class SevSegCore<SevSegT>;
+
+    static_assert(sizeof...(Pins) == SEGMENTS + Digits, "SevSegT needs SEGMENTS + Digits pins");
+    static_assert(Digits <= MAX_DIGITS, "Too many digits");
+    static_assert(Digits <= 8, "SevSegT supports up to 8 digits");
+
+    typedef LED_Pins<Pins...> PinList;
+
+    static const uint16_t SEL_SEG = 0x00FF;                             //!< Segment pins
+    static const uint16_t SEL_DIG = (uint16_t)(((1 << Digits) - 1) << SEGMENTS); //!< Digit pins
+    static const uint16_t SEL_INV = ((Conf & SEG_INVERT) ? SEL_SEG : 0) |
+                                    ((Conf & DIG_INVERT) ? SEL_DIG : 0); //!< Inverted pins
+
+    static const uint8_t s_pins[SEGMENTS + Digits];
+    uint16_t m_sel;                //!< Pin levels of the last slot (before polarity)
+
+    ///
+    /// Update the pins selected by Update on one port
+    /// @param  sel     Pin levels (bit 0 = first pin) before polarity
+    ///
+    template <uint8_t Port, uint16_t Update> static void write(uint16_t sel)
+    {
+        const uint8_t mask = PinList::template bits<Port>(Update);
+        if (mask)
+        {
+            led_port& reg = LED_PortReg(Port);
+            reg = (uint8_t)((reg & ~mask) | PinList::template bits<Port>((uint16_t)((sel ^ SEL_INV) & Update)));
+        }
+    }
+
+    ///
+    /// Show one scan slot: digits leaving off, segments, then digits on.
+    /// Digits lit in both slots stay on.
+    /// @param  sel     Segment mask | (digit mask << SEGMENTS)
+    ///
+    void output(uint16_t sel)
+    {
+        const uint16_t keep = sel & m_sel;
+        m_sel = sel;
+#if defined(__AVR__)
+        uint8_t oldSREG = SREG;
+        cli();
+#endif
+        write<PB, SEL_DIG>(keep);
+        write<PC, SEL_DIG>(keep);
+        write<PD, SEL_DIG>(keep);
+        write<PB, SEL_SEG>(sel);
+        write<PC, SEL_SEG>(sel);
+        write<PD, SEL_SEG>(sel);
+        write<PB, SEL_DIG>(sel);
+        write<PC, SEL_DIG>(sel);
+        write<PD, SEL_DIG>(sel);
+#if defined(__AVR__)
+        SREG = oldSREG;
+#endif
+    }
+
+    /// Turn every digit off
+    void blank(void)
+    {
+        output(0);
+    }
+
+    static void tickDigits(SevSegBase* led)
+    {
+        static_cast<SevSegT*>(led)->scanDigits();
+    }
+
+    static void tickSegments(SevSegBase* led)
+    {
+        static_cast<SevSegT*>(led)->scanSegments();
+    }
+
+public:
+    /// Initialize the pins and turn the display off
+    void begin(void)
+    {
+        this->m_digits = Digits;
+        for (uint8_t i = 0; i < SEGMENTS + Digits; ++i)
+        {
+            pinMode(s_pins[i], OUTPUT);
+        }
+        m_sel = 0;
+        output(0);
+        this->m_last = millis();
+    }
+
+    /// @copydoc SevSeg::refreshDigits
+    void refreshDigits(void)
+    {
+        unsigned long now = millis();
+        if (this->m_timerMode != SCAN_NONE)
+        {
+            this->update();
+        }
+        else if (now != this->m_last)
+        {
+#if LED_STATS
+            const unsigned long start = this->statBegin();
+#endif
+            this->m_last = now;
+#if LED_PLAYER
+            this->tickPlayer(now);
+#endif
+#if LED_BLINK
+            this->tickBlink(now);
+#endif
+            scanDigits();
+#if LED_STATS
+            this->statEnd(start);
+#endif
+            this->update();
+        }
+    }
+
+    /// @copydoc SevSeg::refreshSegments
+    void refreshSegments(void)
+    {
+        unsigned long now = millis();
+        if (this->m_timerMode != SCAN_NONE)
+        {
+            this->update();
+        }
+        else if (now != this->m_last)
+        {
+#if LED_STATS
+            const unsigned long start = this->statBegin();
+#endif
+            this->m_last = now;
+#if LED_PLAYER
+            this->tickPlayer(now);
+#endif
+#if LED_BLINK
+            this->tickBlink(now);
+#endif
+            scanSegments();
+#if LED_STATS
+            this->statEnd(start);
+#endif
+            this->update();
+        }
+    }
+
+    /// @copydoc SevSeg::scanDigits
+    void scanDigits(void)
+    {
+        struct led_page* page = this->nextSlot(SCAN_DIGITS);
+        const uint8_t index = this->m_index;
+        const uint8_t digMask = (uint8_t)(DIG_0 << index);
+#if LED_BLINK
+        const uint8_t segMask = (this->m_blinkOff & digMask) ? this->m_alt[index] : page->buf[index];
+#else
+        const uint8_t segMask = page->buf[index];
+#endif
+        output((uint16_t)(segMask | ((uint16_t)(digMask & this->m_gate) << SEGMENTS)));
+    }
+
+    /// @copydoc SevSeg::scanSegments
+    void scanSegments(void)
+    {
+        struct led_page* page = this->nextSlot(SCAN_SEGMENTS);
+        const uint8_t index = this->m_index;
+        const uint8_t segMask = (uint8_t)(SEG_A << index);
+#if LED_BLINK
+        const uint8_t off = this->m_blinkOff;
+        const uint8_t digMask = (uint8_t)((page->planes[index] & ~off) | (this->m_altPlanes[index] & off));
+#else
+        const uint8_t digMask = page->planes[index];
+#endif
+        output((uint16_t)(segMask | ((uint16_t)(digMask & this->m_gate) << SEGMENTS)));
+    }
+
+    /// @copydoc SevSeg::attachTimer
+    /// SCAN_AUTO is not supported and scans segments.
+    boolean attachTimer(enum led_scan mode, uint16_t hz)
+    {
+        if (mode == SCAN_AUTO)
+            mode = SCAN_SEGMENTS;
+        return this->startTimer(mode, hz, (mode == SCAN_DIGITS) ? tickDigits : tickSegments);
+    }
+};
+
+template <enum led_config Conf, uint8_t Digits, uint8_t... Pins>
+const uint8_t SevSegT<Conf, Digits, Pins...>::s_pins[SEGMENTS + Digits] = { Pins... };
+
+#endif
+
 #endif
@@ -0,0 +1,384 @@
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "LEDDrivers.h"
+
+// Hardware SPI is used through the AVR registers directly so that the
+// SPI library does not have to be included by every sketch.
+#if defined(ARDUINO) && defined(SPCR)
+#define LED_HW_SPI          1
+#else
+#define LED_HW_SPI          0
+#endif
+
+// TM1637 bit time in microseconds (bus runs at up to 250kHz)
+#define TM1637_BIT_USEC     5
+
+///
+/// Construct a serial bus
+/// @param  latch   Latch (RCLK/LOAD) pin
+/// @param  data    Data pin (LED_SPI_PIN = hardware SPI MOSI)
+/// @param  clock   Clock pin (LED_SPI_PIN = hardware SPI SCK)
+///
+LEDSerialBus::LEDSerialBus(uint8_t latch, uint8_t data, uint8_t clock)
+{
+    m_latch = latch;
+    m_data = data;
+    m_clock = clock;
+}
+
+///
+/// Initialize the bus pins (and the SPI peripheral if used)
+///
+void LEDSerialBus::begin(void)
+{
+    pinMode(m_latch, OUTPUT);
+    digitalWrite(m_latch, LOW);
+#if LED_HW_SPI
+    if (m_data == LED_SPI_PIN)
+    {
+        // SS must be an output or the SPI peripheral drops to slave mode
+        pinMode(SS, OUTPUT);
+        pinMode(MOSI, OUTPUT);
+        pinMode(SCK, OUTPUT);
+        // Master, MSB first, mode 0, clk/2
+        SPCR = _BV(SPE) | _BV(MSTR);
+        SPSR = _BV(SPI2X);
+        return;
+    }
+#endif
+    if (m_data != LED_SPI_PIN)
+    {
+        pinMode(m_data, OUTPUT);
+        pinMode(m_clock, OUTPUT);
+    }
+}
+
+///
+/// Send bytes MSB first and pulse the latch
+/// @param  data    Bytes to send (first byte ends up furthest down the chain)
+/// @param  count   Number of bytes
+///
+void LEDSerialBus::write(const uint8_t* data, uint8_t count)
+{
+#if defined(ARDUINO)
+#if LED_HW_SPI
+    if (m_data == LED_SPI_PIN)
+    {
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            SPDR = data[i];
+            while (!(SPSR & _BV(SPIF)))
+                ;
+        }
+    }
+    else
+#endif
+    {
+        for (uint8_t i = 0; i < count; ++i)
+            shiftOut(m_data, m_clock, MSBFIRST, data[i]);
+    }
+#else
+    LED_HostBusWrite(data, count);
+#endif
+    digitalWrite(m_latch, HIGH);
+    digitalWrite(m_latch, LOW);
+}
+
+///
+/// Construct a 74HC595 backend
+/// @param  conf    COMMON_ANODE or COMMON_CATHODE (plus any driver inversion)
+/// @param  latch   RCLK pin
+/// @param  data    SER pin (LED_SPI_PIN = hardware SPI MOSI)
+/// @param  clock   SRCLK pin (LED_SPI_PIN = hardware SPI SCK)
+///
+LED595::LED595(enum led_config conf, uint8_t latch, uint8_t data, uint8_t clock)
+    : m_bus(latch, data, clock)
+{
+    m_config = conf;
+}
+
+///
+/// Initialize the shift registers
+/// @param  digits  Number of digits (1-MAX_DIGITS)
+///
+void LED595::begin(uint8_t digits)
+{
+#if LED_MAX_DIGITS > 8
+    m_digBytes = (uint8_t)((digits + 7) / 8);
+#else
+    (void) digits;
+#endif
+    m_bus.begin();
+}
+
+///
+/// Shift out one scan slot: digit byte then segment byte
+/// @param  seg     Segments to turn on
+/// @param  dig     Digits to turn on
+///
+void LED595::slot(enum led_seg seg, enum led_dig dig)
+{
+#if LED_MAX_DIGITS > 8
+    // Highest digits first: they go to the last register of the chain
+    uint8_t data[(LED_MAX_DIGITS + 7) / 8 + 1];
+    led_digmask bits = (m_config & DIG_INVERT) ? (led_digmask)~dig : (led_digmask)dig;
+    const uint8_t n = m_digBytes;
+    for (uint8_t i = n; i > 0; --i)
+    {
+        data[i - 1] = (uint8_t) bits;
+        bits >>= 8;
+    }
+    data[n] = (m_config & SEG_INVERT) ? (uint8_t)~seg : (uint8_t)seg;
+    m_bus.write(data, (uint8_t)(n + 1));
+#else
+    uint8_t data[2];
+    data[0] = (m_config & DIG_INVERT) ? (uint8_t)~dig : (uint8_t)dig;
+    data[1] = (m_config & SEG_INVERT) ? (uint8_t)~seg : (uint8_t)seg;
+    m_bus.write(data, 2);
+#endif
+}
+
+///
+/// Construct a MAX7219 backend
+/// @param  load    LOAD (CS) pin
+/// @param  data    DIN pin (LED_SPI_PIN = hardware SPI MOSI)
+/// @param  clock   CLK pin (LED_SPI_PIN = hardware SPI SCK)
+///
+LEDMax7219::LEDMax7219(uint8_t load, uint8_t data, uint8_t clock)
+    : m_bus(load, data, clock)
+{
+}
+
+///
+/// Write one MAX7219 register
+/// @param  reg     Register address
+/// @param  data    Register value
+///
+void LEDMax7219::command(uint8_t reg, uint8_t data)
+{
+#if LED_MAX_DIGITS > 8
+    // Same register of every chained controller
+    uint8_t packet[2 * LED_MAX7219_CHIPS];
+    for (uint8_t c = 0; c < m_chips; ++c)
+    {
+        packet[2 * c] = reg;
+        packet[2 * c + 1] = data;
+    }
+    m_bus.write(packet, (uint8_t)(2 * m_chips));
+#else
+    uint8_t packet[2] = { reg, data };
+    m_bus.write(packet, 2);
+#endif
+}
+
+///
+/// Initialize the controller: no decode, scan limit, full intensity, on
+/// @param  digits  Number of digits (1-8)
+///
+void LEDMax7219::begin(uint8_t digits)
+{
+    m_bus.begin();
+#if LED_MAX_DIGITS > 8
+    m_chips = (uint8_t)((digits + 7) / 8);
+#endif
+    command(MAX7219_TEST, 0);
+    command(MAX7219_DECODE, 0);
+#if LED_MAX_DIGITS > 8
+    // Every controller scans 8 digits but the last (first byte sent)
+    uint8_t packet[2 * LED_MAX7219_CHIPS];
+    for (uint8_t c = 0; c < m_chips; ++c)
+    {
+        packet[2 * c] = MAX7219_SCAN_LIMIT;
+        packet[2 * c + 1] = 7;
+    }
+    packet[1] = (uint8_t)((digits - 1) & 7);
+    m_bus.write(packet, (uint8_t)(2 * m_chips));
+#else
+    command(MAX7219_SCAN_LIMIT, (uint8_t)(digits - 1));
+#endif
+    command(MAX7219_INTENSITY, 15);
+    command(MAX7219_SHUTDOWN, 1);
+}
+
+///
+/// Convert segments to the MAX7219 order: DP,A..G from bit 7 down to bit 0
+/// @param  seg     Segments
+/// @return bits    Digit register value
+///
+static uint8_t max7219Bits(uint8_t seg)
+{
+    uint8_t bits = seg & SEG_DP;
+    for (uint8_t s = 0; s < 7; ++s)
+    {
+        if (seg & (1 << s))
+            bits |= (uint8_t)(SEG_G >> s);
+    }
+    return bits;
+}
+
+///
+/// Write the digit registers.  The MAX7219 orders segments DP,A..G from
+/// bit 7 down to bit 0, so A-G are reversed (see max7219Bits()).
+/// @param  buf     Buffer of segments
+/// @param  digits  Number of digits
+///
+void LEDMax7219::frame(const enum led_seg* buf, uint8_t digits)
+{
+#if LED_MAX_DIGITS > 8
+    // One write per register position, reaching every controller: digit
+    // r of the last controller first, controllers without it get a no-op
+    uint8_t packet[2 * LED_MAX7219_CHIPS];
+    const uint8_t rows = (digits < 8) ? digits : 8;
+    for (uint8_t r = 0; r < rows; ++r)
+    {
+        for (uint8_t c = 0; c < m_chips; ++c)
+        {
+            const uint8_t d = (uint8_t)((m_chips - 1 - c) * 8 + r);
+            packet[2 * c] = (d < digits) ? (uint8_t)(MAX7219_DIGIT0 + r) : (uint8_t) MAX7219_NOOP;
+            packet[2 * c + 1] = (d < digits) ? max7219Bits(buf[d]) : 0;
+        }
+        m_bus.write(packet, (uint8_t)(2 * m_chips));
+    }
+#else
+    for (uint8_t d = 0; d < digits; ++d)
+    {
+        command((uint8_t)(MAX7219_DIGIT0 + d), max7219Bits(buf[d]));
+    }
+#endif
+}
+
+///
+/// Set the controller intensity
+/// @param  level   Brightness 0 (off) .. LED_BRIGHT_MAX (full)
+///
+void LEDMax7219::brightness(uint8_t level)
+{
+    if (level == 0)
+    {
+        command(MAX7219_SHUTDOWN, 0);
+        return;
+    }
+    command(MAX7219_INTENSITY, (uint8_t)((level * 15 + LED_BRIGHT_MAX / 2) / LED_BRIGHT_MAX));
+    command(MAX7219_SHUTDOWN, 1);
+}
+
+///
+/// Construct a TM1637 backend
+/// @param  clock   CLK pin
+/// @param  data    DIO pin
+///
+LEDTm1637::LEDTm1637(uint8_t clock, uint8_t data)
+{
+    m_clock = clock;
+    m_data = data;
+    m_control = TM1637_DISPLAY_ON | 7;
+}
+
+#if defined(ARDUINO)
+// The bus is open drain: a line is released (pulled up) as an input and
+// driven low as an output.  The port latch stays LOW throughout.
+#define TM1637_LOW(pin)     pinMode(pin, OUTPUT)
+#define TM1637_HIGH(pin)    pinMode(pin, INPUT)
+#endif
+
+///
+/// Send one command with its data bytes (start, bytes LSB first with ACK,
+/// stop)
+/// @param  data    Command followed by data bytes
+/// @param  count   Number of bytes
+///
+void LEDTm1637::write(const uint8_t* data, uint8_t count)
+{
+#if defined(ARDUINO)
+    TM1637_LOW(m_data);                     // Start
+    delayMicroseconds(TM1637_BIT_USEC);
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        uint8_t bits = data[i];
+        for (uint8_t b = 0; b < 8; ++b)
+        {
+            TM1637_LOW(m_clock);
+            if (bits & 1)
+                TM1637_HIGH(m_data);
+            else
+                TM1637_LOW(m_data);
+            delayMicroseconds(TM1637_BIT_USEC);
+            TM1637_HIGH(m_clock);
+            delayMicroseconds(TM1637_BIT_USEC);
+            bits >>= 1;
+        }
+        TM1637_LOW(m_clock);                // ACK clock (ACK ignored)
+        TM1637_HIGH(m_data);
+        delayMicroseconds(TM1637_BIT_USEC);
+        TM1637_HIGH(m_clock);
+        delayMicroseconds(TM1637_BIT_USEC);
+        TM1637_LOW(m_clock);
+        TM1637_LOW(m_data);
+        delayMicroseconds(TM1637_BIT_USEC);
+    }
+    TM1637_HIGH(m_clock);                   // Stop
+    delayMicroseconds(TM1637_BIT_USEC);
+    TM1637_HIGH(m_data);
+    delayMicroseconds(TM1637_BIT_USEC);
+#else
+    LED_HostBusWrite(data, count);
+#endif
+}
+
+///
+/// Initialize the bus (both lines released)
+/// @param  digits  Number of digits (1-6)
+///
+void LEDTm1637::begin(uint8_t digits)
+{
+    (void) digits;
+#if defined(ARDUINO)
+    digitalWrite(m_clock, LOW);
+    digitalWrite(m_data, LOW);
+    TM1637_HIGH(m_clock);
+    TM1637_HIGH(m_data);
+#endif
+}
+
+///
+/// Write all digits in one auto-increment transfer, then the display
+/// control command.  TM1637 segment bits match enum led_seg.
+/// @param  buf     Buffer of segments
+/// @param  digits  Number of digits
+///
+void LEDTm1637::frame(const enum led_seg* buf, uint8_t digits)
+{
+    uint8_t packet[TM1637_DIGITS + 1];
+    if (digits > TM1637_DIGITS)
+        digits = TM1637_DIGITS;
+    packet[0] = TM1637_DATA;
+    write(packet, 1);
+    packet[0] = TM1637_ADDRESS;
+    for (uint8_t d = 0; d < digits; ++d)
+        packet[d + 1] = buf[d];
+    write(packet, (uint8_t)(digits + 1));
+    write(&m_control, 1);
+}
+
+///
+/// Set the controller brightness
+/// @param  level   Brightness 0 (off) .. LED_BRIGHT_MAX (full)
+///
+void LEDTm1637::brightness(uint8_t level)
+{
+    if (level == 0)
+        m_control = TM1637_DISPLAY_OFF;
+    else
+        m_control = (uint8_t)(TM1637_DISPLAY_ON | ((level * 7 + LED_BRIGHT_MAX / 2) / LED_BRIGHT_MAX));
+    write(&m_control, 1);
+}
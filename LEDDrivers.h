@@ -0,0 +1,137 @@
+#ifndef LED_DRIVERS_H_FILE
+#define LED_DRIVERS_H_FILE
+///
+/// @file LEDDrivers.h
+///
+/// Output backends for SevSeg that need fewer pins than driving every
+/// segment and digit line directly.  Each scan slot (74HC595) or each
+/// committed frame (MAX7219, TM1637) goes out as one batched transfer.
+///
+///     LED595 out(COMMON_CATHODE, 10);     // Latch on D10, hardware SPI
+///     SevSeg led7seg;
+///     led7seg.begin(&out, 4);
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "LED7Seg.h"
+
+/// Pin value selecting the hardware SPI pins (MOSI/SCK)
+#define LED_SPI_PIN         0xFF
+
+///
+/// Serial output used by the shift register and MAX7219 backends: hardware
+/// SPI when available and requested, otherwise shiftOut() on any two pins.
+/// Each transfer is framed by a latch (load) pulse.
+/// @brief LED serial bus
+///
+class LEDSerialBus
+{
+public:
+    LEDSerialBus(uint8_t latch, uint8_t data, uint8_t clock);
+    void begin(void);
+    void write(const uint8_t* data, uint8_t count);
+protected:
+    uint8_t m_latch;                //!< Latch (RCLK/LOAD) pin
+    uint8_t m_data;                 //!< Data pin or LED_SPI_PIN
+    uint8_t m_clock;                //!< Clock pin or LED_SPI_PIN
+};
+
+///
+/// Two chained 74HC595 shift registers: the first holds segments A-G,DP on
+/// Q0-Q7, the second holds digits 0-7 on Q0-Q7.  SevSeg multiplexes the
+/// display as with direct pins, writing both bytes once per scan slot.
+/// Longer displays (LED_MAX_DIGITS > 8) chain one more register per 8
+/// digits: digits 8-15 on the third, and so on.
+/// @brief 74HC595 output backend
+///
+class LED595 : public LEDOutput
+{
+public:
+    LED595(enum led_config conf, uint8_t latch, uint8_t data = LED_SPI_PIN, uint8_t clock = LED_SPI_PIN);
+    void begin(uint8_t digits);
+    void slot(enum led_seg seg, enum led_dig dig);
+protected:
+    LEDSerialBus m_bus;             //!< Serial output
+    uint8_t m_config;               //!< SEG_INVERT/DIG_INVERT
+#if LED_MAX_DIGITS > 8
+    uint8_t m_digBytes;             //!< Digit registers (8 digits each)
+#endif
+};
+
+///
+/// MAX7219/MAX7221 LED controller (no-decode mode).  The controller
+/// multiplexes the display itself; SevSeg sends the digit registers once
+/// per commit().  Longer displays (LED_MAX_DIGITS > 8) daisy-chain one
+/// controller per 8 digits, digits 0-7 on the one wired to the Arduino.
+/// @brief MAX7219 output backend
+///
+class LEDMax7219 : public LEDOutput
+{
+public:
+    LEDMax7219(uint8_t load, uint8_t data = LED_SPI_PIN, uint8_t clock = LED_SPI_PIN);
+    void begin(uint8_t digits);
+    void frame(const enum led_seg* buf, uint8_t digits);
+    void brightness(uint8_t level);
+protected:
+    LEDSerialBus m_bus;             //!< Serial output
+#if LED_MAX_DIGITS > 8
+    uint8_t m_chips;                //!< Chained controllers (8 digits each)
+#endif
+    void command(uint8_t reg, uint8_t data);
+};
+
+/// Chained MAX7219 controllers at most
+#define LED_MAX7219_CHIPS   ((LED_MAX_DIGITS + 7) / 8)
+
+///
+/// TM1637 LED controller (2-wire CLK/DIO bus).  The controller multiplexes
+/// the display itself; SevSeg sends all digits in one auto-increment write
+/// per commit().
+/// @brief TM1637 output backend
+///
+class LEDTm1637 : public LEDOutput
+{
+public:
+    LEDTm1637(uint8_t clock, uint8_t data);
+    void begin(uint8_t digits);
+    void frame(const enum led_seg* buf, uint8_t digits);
+    void brightness(uint8_t level);
+protected:
+    uint8_t m_clock;                //!< CLK pin
+    uint8_t m_data;                 //!< DIO pin
+    uint8_t m_control;              //!< Display control command (on/off + brightness)
+    void write(const uint8_t* data, uint8_t count);
+};
+
+/// MAX7219 registers
+enum led_max7219
+{
+    MAX7219_NOOP=0x00,              //!< No-op (passes a chained write on)
+    MAX7219_DIGIT0=0x01,            //!< Digit 0 register (digits 0-7 = 0x01-0x08)
+    MAX7219_DECODE=0x09,            //!< Decode mode
+    MAX7219_INTENSITY=0x0A,         //!< Intensity 0-15
+    MAX7219_SCAN_LIMIT=0x0B,        //!< Number of digits - 1
+    MAX7219_SHUTDOWN=0x0C,          //!< 0 = shutdown, 1 = normal operation
+    MAX7219_TEST=0x0F               //!< Display test
+};
+
+/// TM1637 commands
+enum led_tm1637
+{
+    TM1637_DATA=0x40,               //!< Data command: write, auto increment
+    TM1637_ADDRESS=0xC0,            //!< Address command: digit 0
+    TM1637_DISPLAY_OFF=0x80,        //!< Display control: off
+    TM1637_DISPLAY_ON=0x88,         //!< Display control: on | brightness 0-7
+    TM1637_DIGITS=6                 //!< Maximum number of digits
+};
+
+#endif
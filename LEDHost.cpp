@@ -0,0 +1,459 @@
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#if !defined(ARDUINO)
+#include "LED7Seg.h"
+#include <vector>
+#include <string.h>
+
+LED_HostReg LED_HostPort[HOST_PORTS] = { { 0, HOST_PORTB }, { 0, HOST_PORTC }, { 0, HOST_PORTD } };
+volatile uint8_t LED_HostDdr[HOST_PORTS];
+
+static std::vector<struct led_host_event> s_trace;  // Register changes
+static std::vector<struct led_host_packet> s_bus;   // Serial bus transfers
+static std::vector<uint16_t> s_keys;                // Keys down (drive << 8 | return pin)
+
+static unsigned long s_usec;               // Virtual time in microseconds
+static unsigned long s_timerPeriod;        // Simulated timer period (0=stopped)
+static unsigned long s_timerNext;          // Virtual time of next timer tick
+static void (*s_timerIsr)(void);           // Simulated timer interrupt handler
+static unsigned long s_ticks;              // Simulated timer interrupts
+static unsigned long s_wakes;              // Wake-ups from LED_HostSleep()
+
+///
+/// Map a pin number to its mock port index (Uno/Nano numbering)
+/// @param  pin     Digital pin number
+/// @return index   HOST_PORTB..HOST_PORTD or HOST_PORTS if not a pin
+///
+static uint8_t hostPortIndex(uint8_t pin)
+{
+    if (pin < 8)
+        return HOST_PORTD;
+    if (pin < 14)
+        return HOST_PORTB;
+    if (pin < 20)
+        return HOST_PORTC;
+    return HOST_PORTS;
+}
+
+uint8_t digitalPinToPort(uint8_t pin)
+{
+    static const uint8_t ports[HOST_PORTS + 1] = { PB, PC, PD, NOT_A_PIN };
+    return ports[hostPortIndex(pin)];
+}
+
+uint8_t digitalPinToBitMask(uint8_t pin)
+{
+    if (pin < 8)
+        return (uint8_t)(1 << pin);
+    if (pin < 14)
+        return (uint8_t)(1 << (pin - 8));
+    if (pin < 20)
+        return (uint8_t)(1 << (pin - 14));
+    return 0;
+}
+
+led_port* portOutputRegister(uint8_t port)
+{
+    if (port < PB || port > PD)
+        return 0;
+    return &LED_HostPort[port - PB];
+}
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    uint8_t port = hostPortIndex(pin);
+    if (port < HOST_PORTS)
+    {
+        if (mode == OUTPUT)
+            LED_HostDdr[port] |= digitalPinToBitMask(pin);
+        else
+            LED_HostDdr[port] &= (uint8_t)~digitalPinToBitMask(pin);
+        // The AVR pull-up is enabled by writing the output bit
+        if (mode == INPUT_PULLUP)
+            LED_HostPort[port] |= digitalPinToBitMask(pin);
+        else if (mode == INPUT)
+            LED_HostPort[port] &= (uint8_t)~digitalPinToBitMask(pin);
+    }
+}
+
+void digitalWrite(uint8_t pin, uint8_t val)
+{
+    uint8_t port = hostPortIndex(pin);
+    if (port < HOST_PORTS)
+    {
+        if (val == LOW)
+            LED_HostPort[port] &= (uint8_t)~digitalPinToBitMask(pin);
+        else
+            LED_HostPort[port] |= digitalPinToBitMask(pin);
+    }
+}
+
+///
+/// Read the output level of a pin
+/// @param  pin     Digital pin number
+/// @return level   HIGH or LOW
+///
+static int hostLevel(uint8_t pin)
+{
+    uint8_t port = hostPortIndex(pin);
+    if (port < HOST_PORTS && (LED_HostPort[port] & digitalPinToBitMask(pin)))
+        return HIGH;
+    return LOW;
+}
+
+int digitalRead(uint8_t pin)
+{
+    int level = hostLevel(pin);
+    uint8_t port = hostPortIndex(pin);
+    if (port < HOST_PORTS && !(LED_HostDdr[port] & digitalPinToBitMask(pin)))
+    {
+        // Input: pulled up (or down), a key passes on the opposite level
+        for (unsigned long i = 0; i < s_keys.size(); ++i)
+        {
+            if ((s_keys[i] & 0xFF) == pin && hostLevel((uint8_t)(s_keys[i] >> 8)) != level)
+                return !level;
+        }
+    }
+    return level;
+}
+
+///
+/// Write a mock register, recording the change in the trace
+/// @param  value   New register value
+///
+LED_HostReg& LED_HostReg::operator=(uint8_t value)
+{
+    if (value != m_value)
+    {
+        struct led_host_event event = { s_usec, m_port, value };
+        s_trace.push_back(event);
+        m_value = value;
+    }
+    return *this;
+}
+
+unsigned long millis(void)
+{
+    return s_usec / 1000;
+}
+
+unsigned long micros(void)
+{
+    return s_usec;
+}
+
+///
+/// Clear the mock register file and trace and rewind virtual time to 0
+///
+void LED_HostReset(void)
+{
+    for (uint8_t p = 0; p < HOST_PORTS; ++p)
+    {
+        LED_HostPort[p].m_value = 0;
+        LED_HostDdr[p] = 0;
+    }
+    s_trace.clear();
+    s_bus.clear();
+    s_keys.clear();
+    s_usec = 0;
+    s_timerPeriod = 0;
+    s_timerIsr = 0;
+    s_ticks = 0;
+    s_wakes = 0;
+}
+
+///
+/// Advance virtual time, calling the simulated timer interrupt handler
+/// at each tick that falls due.
+/// @param  usec    Number of microseconds to advance
+///
+void LED_HostAdvance(unsigned long usec)
+{
+    unsigned long end = s_usec + usec;
+    while (s_timerPeriod && (long)(end - s_timerNext) >= 0)
+    {
+        s_usec = s_timerNext;
+        ++s_ticks;
+        s_timerIsr();
+        // A period written by the handler applies to the next interval
+        s_timerNext = s_usec + s_timerPeriod;
+    }
+    s_usec = end;
+}
+
+///
+/// Start the simulated timer used in place of a hardware compare interrupt
+/// @param  period  Tick period in microseconds (0 = stop)
+/// @param  isr     Interrupt handler called once per tick
+///
+void LED_HostTimerStart(unsigned long period, void (*isr)(void))
+{
+    s_timerPeriod = isr ? period : 0;
+    s_timerIsr = isr;
+    s_timerNext = s_usec + period;
+}
+
+///
+/// Change the simulated timer period, like writing the compare register
+/// from the interrupt handler.
+/// @param  period  Tick period in microseconds
+///
+void LED_HostTimerPeriod(unsigned long period)
+{
+    if (s_timerPeriod)
+        s_timerPeriod = period;
+}
+
+///
+/// Let virtual time run to the next simulated timer tick.  Used where the
+/// library busy-waits for the timer interrupt.
+///
+void LED_HostYield(void)
+{
+    if (s_timerPeriod)
+        LED_HostAdvance(s_timerNext - s_usec);
+}
+
+///
+/// Sleep until the next interrupt: the simulated timer tick or the next
+/// millisecond (the millis() timer of the Arduino core), whichever is
+/// first.  Used in place of the AVR idle sleep.
+///
+void LED_HostSleep(void)
+{
+    unsigned long next = (s_usec / 1000 + 1) * 1000;
+    if (s_timerPeriod && (long)(s_timerNext - next) < 0)
+        next = s_timerNext;
+    LED_HostAdvance(next - s_usec);
+    ++s_wakes;
+}
+
+///
+/// Get the number of wake-ups from LED_HostSleep() since LED_HostReset()
+/// @return count   Number of wake-ups
+///
+unsigned long LED_HostWakes(void)
+{
+    return s_wakes;
+}
+
+///
+/// Get the number of simulated timer interrupts since LED_HostReset()
+/// @return count   Number of timer interrupts
+///
+unsigned long LED_HostTicks(void)
+{
+    return s_ticks;
+}
+
+///
+/// Get the register trace recorded since LED_HostReset()
+/// @param  count   Returns the number of entries
+/// @return trace   Trace entries in time order
+///
+const struct led_host_event* LED_HostTrace(unsigned long* count)
+{
+    *count = s_trace.size();
+    return s_trace.empty() ? 0 : &s_trace[0];
+}
+
+///
+/// Count pin transitions (bits changed) within a time window
+/// @param  from    Start time in microseconds (inclusive)
+/// @param  to      End time in microseconds (exclusive)
+/// @return count   Number of pin transitions
+///
+unsigned long LED_HostTransitions(unsigned long from, unsigned long to)
+{
+    uint8_t state[HOST_PORTS] = { 0, 0, 0 };
+    unsigned long count = 0;
+    for (unsigned long i = 0; i < s_trace.size(); ++i)
+    {
+        const struct led_host_event& event = s_trace[i];
+        if (event.usec >= to)
+            break;
+        if (event.usec >= from)
+        {
+            uint8_t diff = (uint8_t)(state[event.port] ^ event.value);
+            while (diff)
+            {
+                count += diff & 1;
+                diff >>= 1;
+            }
+        }
+        state[event.port] = event.value;
+    }
+    return count;
+}
+
+///
+/// Press or release a simulated key between two pins.  While it is down,
+/// an input pin reads the level of the drive pin when that is the
+/// opposite of its pull-up (INPUT_PULLUP) or pull-down (INPUT) level.
+/// @param  drive   Pin driving the key (e.g. a digit pin)
+/// @param  ret     Input pin reading the key
+/// @param  down    true = press, false = release
+///
+void LED_HostKey(uint8_t drive, uint8_t ret, bool down)
+{
+    const uint16_t key = (uint16_t)(drive << 8 | ret);
+    for (unsigned long i = 0; i < s_keys.size(); ++i)
+    {
+        if (s_keys[i] == key)
+        {
+            if (!down)
+                s_keys.erase(s_keys.begin() + i);
+            return;
+        }
+    }
+    if (down)
+        s_keys.push_back(key);
+}
+
+///
+/// Record a serial bus transfer.  Output backends call this in place of
+/// clocking the bytes out on the host.
+/// @param  data    Bytes in transfer order
+/// @param  count   Number of bytes (at most HOST_PACKET_MAX are kept)
+///
+void LED_HostBusWrite(const uint8_t* data, uint8_t count)
+{
+    struct led_host_packet packet;
+    packet.usec = s_usec;
+    packet.count = (count < HOST_PACKET_MAX) ? count : HOST_PACKET_MAX;
+    for (uint8_t i = 0; i < packet.count; ++i)
+        packet.data[i] = data[i];
+    s_bus.push_back(packet);
+}
+
+///
+/// Get the serial bus transfers recorded since LED_HostReset()
+/// @param  count   Returns the number of packets
+/// @return packets Packets in time order
+///
+const struct led_host_packet* LED_HostBus(unsigned long* count)
+{
+    *count = s_bus.size();
+    return s_bus.empty() ? 0 : &s_bus[0];
+}
+
+size_t Print::write(const uint8_t* buffer, size_t size)
+{
+    size_t n = 0;
+    while (size--)
+        n += write(*buffer++);
+    return n;
+}
+
+size_t Print::write(const char* str)
+{
+    return str ? write((const uint8_t*) str, strlen(str)) : 0;
+}
+
+size_t Print::print(const char* str)
+{
+    return write(str);
+}
+
+size_t Print::print(const __FlashStringHelper* str)
+{
+    return write((const char*) str);
+}
+
+size_t Print::print(char c)
+{
+    return write((uint8_t) c);
+}
+
+size_t Print::print(int num, int base)
+{
+    return print((long) num, base);
+}
+
+size_t Print::print(unsigned int num, int base)
+{
+    return print((unsigned long) num, base);
+}
+
+size_t Print::print(long num, int base)
+{
+    if (base == DEC && num < 0)
+        return print('-') + printNumber((unsigned long) -num, DEC);
+    return printNumber((unsigned long) num, (uint8_t) base);
+}
+
+size_t Print::print(unsigned long num, int base)
+{
+    return printNumber(num, (uint8_t) base);
+}
+
+size_t Print::print(double num, int digits)
+{
+    // Same algorithm as the Arduino core
+    size_t n = 0;
+    if (num < 0.0)
+    {
+        n += print('-');
+        num = -num;
+    }
+    double rounding = 0.5;
+    for (int i = 0; i < digits; ++i)
+        rounding /= 10.0;
+    num += rounding;
+    unsigned long whole = (unsigned long) num;
+    double rest = num - (double) whole;
+    n += print(whole);
+    if (digits > 0)
+        n += print('.');
+    while (digits-- > 0)
+    {
+        rest *= 10.0;
+        unsigned int digit = (unsigned int) rest;
+        n += print(digit);
+        rest -= digit;
+    }
+    return n;
+}
+
+size_t Print::println(void)
+{
+    return write((const uint8_t*) "\r\n", 2);
+}
+
+size_t Print::println(const char* str)
+{
+    return print(str) + println();
+}
+
+size_t Print::println(double num, int digits)
+{
+    return print(num, digits) + println();
+}
+
+size_t Print::printNumber(unsigned long num, uint8_t base)
+{
+    char buf[8 * sizeof(long) + 1];
+    char* str = &buf[sizeof(buf) - 1];
+    *str = 0;
+    if (base < 2)
+        base = 10;
+    do
+    {
+        char c = (char)(num % base);
+        num /= base;
+        *--str = (char)(c < 10 ? c + '0' : c + 'A' - 10);
+    } while (num);
+    return write(str);
+}
+
+#endif
@@ -0,0 +1,199 @@
+#ifndef LED_HOST_H_FILE
+#define LED_HOST_H_FILE
+///
+/// @file LEDHost.h
+///
+/// Host (non-Arduino) stand-ins for the parts of the Arduino core used
+/// by LED7Seg.  Pins use the Arduino Uno/Nano (ATmega328P) numbering and
+/// are mapped onto a mock register file (PORTB, PORTC, PORTD) so that
+/// digitalWrite() and direct port output end up in the same registers.
+/// Keys between two pins can be simulated with LED_HostKey().  Every
+/// change of an output register is recorded with its virtual timestamp;
+/// see LEDSim.h for turning the trace into a display.
+///
+/// Build on Linux with e.g.
+///
+///     g++ -I. LED7Seg.cpp LEDFont.cpp LEDHost.cpp LEDSim.cpp main.cpp
+///
+/// The host checks in test/ are built this way (make -C test).
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include <stdint.h>
+#include <stddef.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define LOW         0
+#define HIGH        1
+#define INPUT       0
+#define OUTPUT      1
+#define INPUT_PULLUP 2
+
+// Strings in flash are ordinary strings on the host
+class __FlashStringHelper;
+#define F(s)        ((const __FlashStringHelper*)(s))
+#define PSTR(s)     (s)
+
+// Analog pins as digital pin numbers (Uno/Nano)
+#define A0          14
+#define A1          15
+#define A2          16
+#define A3          17
+#define A4          18
+#define A5          19
+#define A6          20
+#define A7          21
+
+// Port numbers as returned by digitalPinToPort()
+#define NOT_A_PIN   0
+#define PB          2
+#define PC          3
+#define PD          4
+
+/*!
+ *  @ingroup Types
+ *  @brief Mock port index (PORTB, PORTC, PORTD)
+ */
+enum led_host_port
+{
+    HOST_PORTB=0,           /*!< Mock PORTB (D8-D13) */
+    HOST_PORTC=1,           /*!< Mock PORTC (A0-A5) */
+    HOST_PORTD=2,           /*!< Mock PORTD (D0-D7) */
+    HOST_PORTS=3            /*!< Number of mock ports */
+};
+
+///
+/// Mock output register.  Reads return the current value; writes are
+/// recorded in the trace when they change any bit.
+/// @brief Mock port register
+///
+class LED_HostReg
+{
+public:
+    uint8_t m_value;                    //!< Current register value
+    uint8_t m_port;                     //!< Port index (HOST_PORTB..HOST_PORTD)
+
+    operator uint8_t() const
+    {
+        return m_value;
+    }
+    LED_HostReg& operator=(uint8_t value);
+    LED_HostReg& operator|=(uint8_t bits)
+    {
+        return *this = (uint8_t)(m_value | bits);
+    }
+    LED_HostReg& operator&=(uint8_t bits)
+    {
+        return *this = (uint8_t)(m_value & bits);
+    }
+};
+
+/// Output port register type (volatile uint8_t on AVR)
+typedef LED_HostReg led_port;
+
+/*!
+ *  @ingroup Types
+ *  @brief Trace entry: an output register changed value
+ */
+struct led_host_event
+{
+    unsigned long usec;                 //!< Virtual time in microseconds
+    uint8_t port;                       //!< Port index (HOST_PORTB..HOST_PORTD)
+    uint8_t value;                      //!< New register value
+};
+
+/// Maximum bytes recorded per serial bus packet
+#define HOST_PACKET_MAX     16
+
+/*!
+ *  @ingroup Types
+ *  @brief Trace entry: a serial bus transfer (shift register or controller)
+ */
+struct led_host_packet
+{
+    unsigned long usec;                 //!< Virtual time in microseconds
+    uint8_t count;                      //!< Number of bytes
+    uint8_t data[HOST_PACKET_MAX];      //!< Bytes in transfer order
+};
+
+extern LED_HostReg LED_HostPort[HOST_PORTS];        //!< Mock PORTx output registers
+extern volatile uint8_t LED_HostDdr[HOST_PORTS];    //!< Mock DDRx direction registers
+
+#define PORTB       (LED_HostPort[HOST_PORTB])
+#define PORTC       (LED_HostPort[HOST_PORTC])
+#define PORTD       (LED_HostPort[HOST_PORTD])
+#define DDRB        (LED_HostDdr[HOST_PORTB])
+#define DDRC        (LED_HostDdr[HOST_PORTC])
+#define DDRD        (LED_HostDdr[HOST_PORTD])
+
+uint8_t digitalPinToPort(uint8_t pin);
+uint8_t digitalPinToBitMask(uint8_t pin);
+led_port* portOutputRegister(uint8_t port);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+unsigned long millis(void);
+unsigned long micros(void);
+
+// Arduino Uno/Nano clock for cycle estimates
+#define clockCyclesPerMicrosecond() 16UL
+
+#define DEC         10
+#define HEX         16
+#define OCT         8
+#define BIN         2
+
+///
+/// Arduino Print stand-in: the print() overloads format text and numbers
+/// and hand the characters to write().
+/// @brief Print interface
+///
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str);
+    size_t print(const char* str);
+    size_t print(const __FlashStringHelper* str);
+    size_t print(char c);
+    size_t print(int num, int base = DEC);
+    size_t print(unsigned int num, int base = DEC);
+    size_t print(long num, int base = DEC);
+    size_t print(unsigned long num, int base = DEC);
+    size_t print(double num, int digits = 2);
+    size_t println(void);
+    size_t println(const char* str);
+    size_t println(double num, int digits = 2);
+protected:
+    size_t printNumber(unsigned long num, uint8_t base);
+};
+
+void LED_HostReset(void);
+void LED_HostAdvance(unsigned long usec);
+void LED_HostTimerStart(unsigned long period, void (*isr)(void));
+void LED_HostTimerPeriod(unsigned long period);
+void LED_HostYield(void);
+void LED_HostSleep(void);
+unsigned long LED_HostWakes(void);
+unsigned long LED_HostTicks(void);
+const struct led_host_event* LED_HostTrace(unsigned long* count);
+unsigned long LED_HostTransitions(unsigned long from, unsigned long to);
+void LED_HostKey(uint8_t drive, uint8_t ret, bool down);
+void LED_HostBusWrite(const uint8_t* data, uint8_t count);
+const struct led_host_packet* LED_HostBus(unsigned long* count);
+
+#endif
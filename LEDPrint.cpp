@@ -0,0 +1,192 @@
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "LEDPrint.h"
+
+///
+/// Construct a Print adapter
+/// @param  led     Display to print to
+/// @param  right   true to right justify lines (numbers), false for left
+///
+LEDPrint::LEDPrint(SevSegBase& led, boolean right)
+    : m_led(led)
+{
+    m_right = right;
+    clear();
+}
+
+///
+/// Clear the current line (the display is updated by the next write)
+///
+void LEDPrint::clear(void)
+{
+    m_count = 0;
+    m_fold = false;
+    m_newLine = false;
+}
+
+///
+/// Add one character to the line without updating the display
+/// @param  c       ASCII character
+///
+void LEDPrint::put(uint8_t c)
+{
+    if (c == '\r')
+        return;
+    if (c == '\n')
+    {
+        m_newLine = true;
+        return;
+    }
+    if (m_newLine)
+        clear();
+    if (c == '.' && m_fold)
+    {
+        m_line[m_count - 1] = (enum led_seg)(m_line[m_count - 1] | SEG_DP);
+        m_fold = false;
+        return;
+    }
+    if (m_count < m_led.digitCount())
+    {
+        const uint8_t index = c - ' ';
+        m_line[m_count++] = LED_GET_FONT(LED_AsciiFont, index);
+        m_fold = (c != '.');
+    }
+    else
+        m_fold = false;
+}
+
+///
+/// Show the current line on the display
+///
+void LEDPrint::show(void)
+{
+    const uint8_t digits = m_led.digitCount();
+    const uint8_t pad = m_right ? (uint8_t)(digits - m_count) : 0;
+    enum led_seg buf[MAX_DIGITS];
+    for (uint8_t d = 0; d < digits; ++d)
+    {
+        buf[d] = (d >= pad && d < pad + m_count) ? m_line[d - pad] : LED_BLANK;
+    }
+    m_led.showRaw(buf);
+}
+
+///
+/// Print one character
+/// @param  c       ASCII character
+/// @return count   1
+///
+size_t LEDPrint::write(uint8_t c)
+{
+    put(c);
+    show();
+    return 1;
+}
+
+///
+/// Print a block of characters, updating the display once
+/// @param  buffer  Characters
+/// @param  size    Number of characters
+/// @return count   Number of characters
+///
+size_t LEDPrint::write(const uint8_t* buffer, size_t size)
+{
+    for (size_t i = 0; i < size; ++i)
+    {
+        put(buffer[i]);
+    }
+    show();
+    return size;
+}
+
+///
+/// Print a number with a fixed number of decimals.  Uses 32-bit fixed
+/// point instead of the floating point formatter of Print or printf.
+/// @param  num     Number to print
+/// @param  digits  Number of decimals (0-9); reduced to fit the display
+/// @return count   Number of characters printed
+///
+size_t LEDPrint::print(double num, int digits)
+{
+    char buf[MAX_DIGITS * 2 + 2];
+    uint8_t len = 0;
+    if (m_newLine)
+        clear();
+    const uint8_t avail = (uint8_t)(m_led.digitCount() - m_count);
+
+    if (num != num || num - num != 0)
+    {
+        // NaN or infinite
+        buf[len++] = 'E';
+        return write((const uint8_t*) buf, len);
+    }
+    boolean neg = num < 0;
+    if (neg)
+        num = -num;
+    uint8_t dp = (digits < 0) ? 0 : (digits > 9) ? 9 : (uint8_t) digits;
+    uint32_t fixed = 0;
+    uint8_t width = 0;
+    for (;;)
+    {
+        // Round at dp decimals and count the digits (at least dp + 1)
+        const double scaled = num * (double) pgm_read_dword(LED_Pow10 + dp) + 0.5;
+        if (scaled < 4294967295.0)
+        {
+            fixed = (uint32_t) scaled;
+            width = dp + 1;
+            while (width < 10 && fixed >= pgm_read_dword(LED_Pow10 + width))
+                ++width;
+            if (fixed == 0)
+                neg = false;
+            if (width + neg <= avail)
+                break;
+        }
+        if (dp == 0)
+        {
+            // Integer part does not fit: "----"
+            for (len = 0; len < avail; ++len)
+                buf[len] = '-';
+            return write((const uint8_t*) buf, len);
+        }
+        --dp;
+    }
+    if (neg)
+        buf[len++] = '-';
+    // Digits by repeated subtraction (no 32-bit division)
+    for (uint8_t p = width; p > 0; --p)
+    {
+        const uint32_t pow = pgm_read_dword(LED_Pow10 + p - 1);
+        char c = '0';
+        while (fixed >= pow)
+        {
+            fixed -= pow;
+            ++c;
+        }
+        buf[len++] = c;
+        if (p - 1 == dp && dp)
+            buf[len++] = '.';
+    }
+    return write((const uint8_t*) buf, len);
+}
+
+///
+/// Print a number with a fixed number of decimals and end the line.
+/// Print::println(double) would call Print::print(double), which is not
+/// virtual, so it is replaced too.
+/// @param  num     Number to print
+/// @param  digits  Number of decimals (0-9); reduced to fit the display
+/// @return count   Number of characters printed
+///
+size_t LEDPrint::println(double num, int digits)
+{
+    return print(num, digits) + println();
+}
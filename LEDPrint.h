@@ -0,0 +1,66 @@
+#ifndef LED_PRINT_H_FILE
+#define LED_PRINT_H_FILE
+///
+/// @file LEDPrint.h
+///
+/// Arduino Print adapter for SevSeg, so the usual print() overloads
+/// render into the display:
+///
+///     SevSeg led7seg;
+///     LEDPrint lcd(led7seg);
+///
+///     lcd.print(12.5, 1);         // " 12.5" -> digits "12.5" with one DP
+///     lcd.println(0xBEEF, HEX);
+///     lcd.println("Err");
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "LED7Seg.h"
+
+///
+/// Print adapter for SevSeg or SevSegT.  Characters accumulate into a
+/// line of glyphs (a '.' folds into the previous glyph) that is shown left
+/// or right justified.  A newline ends the line: the next character starts
+/// a new one.  Characters past the display width are dropped.
+///
+/// print(double) is replaced by a compact fixed-point formatter (no
+/// floating point printf): it rounds to the requested decimals, drops
+/// decimals that do not fit and shows "----" if the integer part does not
+/// fit, or "E" for NaN and infinity.
+/// @brief LED Print adapter
+///
+class LEDPrint : public Print
+{
+public:
+    LEDPrint(SevSegBase& led, boolean right = true);
+
+    size_t write(uint8_t c);
+    size_t write(const uint8_t* buffer, size_t size);
+    using Print::write;
+    using Print::print;
+    using Print::println;
+    size_t print(double num, int digits = 2);
+    size_t println(double num, int digits = 2);
+    void clear(void);
+protected:
+    SevSegBase& m_led;              //!< Display
+    enum led_seg m_line[MAX_DIGITS]; //!< Glyphs of the current line
+    uint8_t m_count;                //!< Number of glyphs in the line
+    uint8_t m_right;                //!< Right justify the line
+    uint8_t m_fold;                 //!< A '.' may fold into the last glyph
+    uint8_t m_newLine;              //!< The next character starts a new line
+
+    void put(uint8_t c);
+    void show(void);
+};
+
+#endif
@@ -0,0 +1,327 @@
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#if !defined(ARDUINO)
+#include "LEDSim.h"
+#include "LEDDrivers.h"
+
+///
+/// Test whether a pin is driven to its active level
+/// @param  state   Port register values
+/// @param  pin     Digital pin number
+/// @param  invert  true if the pin is active low
+///
+static boolean pinActive(const uint8_t* state, uint8_t pin, boolean invert)
+{
+    uint8_t port = digitalPinToPort(pin);
+    boolean high = port != NOT_A_PIN && (state[port - PB] & digitalPinToBitMask(pin));
+    return high != invert;
+}
+
+///
+/// Accumulate lit time for one interval of constant register state
+///
+static void accumulate(struct led_sim_view* view, const uint8_t* state, enum led_config conf,
+                       const uint8_t* pins, unsigned long usec)
+{
+    if (usec == 0)
+        return;
+    for (uint8_t d = 0; d < view->digits; ++d)
+    {
+        if (!pinActive(state, pins[SEGMENTS + d], conf & DIG_INVERT))
+            continue;
+        view->digitOn[d] += usec;
+        for (uint8_t s = 0; s < SEGMENTS; ++s)
+        {
+            if (pinActive(state, pins[s], conf & SEG_INVERT))
+                view->segOn[d][s] += usec;
+        }
+    }
+}
+
+///
+/// Clear a view before accumulating lit time
+///
+static void clearView(struct led_sim_view* view, uint8_t digits, unsigned long span)
+{
+    view->span = span;
+    view->digits = digits;
+    for (uint8_t d = 0; d < MAX_DIGITS; ++d)
+    {
+        view->digitOn[d] = 0;
+        view->seg[d] = SEG_NONE;
+        for (uint8_t s = 0; s < SEGMENTS; ++s)
+        {
+            view->segOn[d][s] = 0;
+        }
+    }
+}
+
+///
+/// Decide which segments are perceived as lit from the accumulated times
+///
+static void perceive(struct led_sim_view* view)
+{
+    unsigned long brightest = 0;
+    for (uint8_t d = 0; d < view->digits; ++d)
+    {
+        for (uint8_t s = 0; s < SEGMENTS; ++s)
+        {
+            if (view->segOn[d][s] > brightest)
+                brightest = view->segOn[d][s];
+        }
+    }
+    for (uint8_t d = 0; d < view->digits; ++d)
+    {
+        for (uint8_t s = 0; s < SEGMENTS; ++s)
+        {
+            if (brightest && view->segOn[d][s] * 32 >= brightest)
+                view->seg[d] = (enum led_seg)(view->seg[d] | (SEG_A << s));
+        }
+    }
+}
+
+///
+/// Reconstruct the perceived display over a time window of the trace.
+/// A segment is perceived as lit when it was on for at least 1/32 of the
+/// time of the brightest segment, so dimmed digits show but zero-length
+/// glitches and faint ghosting do not.
+/// @param  view    Returns the reconstructed display
+/// @param  conf    COMMON_ANODE or COMMON_CATHODE
+/// @param  digits  Number of digits
+/// @param  pins    Segment pins A-G,DP followed by the digit pins
+/// @param  from    Start time in microseconds (inclusive)
+/// @param  to      End time in microseconds (exclusive)
+///
+void LED_SimView(struct led_sim_view* view, enum led_config conf, uint8_t digits,
+                 const uint8_t* pins, unsigned long from, unsigned long to)
+{
+    unsigned long count;
+    const struct led_host_event* trace = LED_HostTrace(&count);
+    uint8_t state[HOST_PORTS] = { 0, 0, 0 };
+    unsigned long now = from;
+
+    clearView(view, digits, to - from);
+    for (unsigned long i = 0; i < count && trace[i].usec < to; ++i)
+    {
+        if (trace[i].usec > now)
+        {
+            accumulate(view, state, conf, pins, trace[i].usec - now);
+            now = trace[i].usec;
+        }
+        state[trace[i].port] = trace[i].value;
+    }
+    if (to > now)
+        accumulate(view, state, conf, pins, to - now);
+    perceive(view);
+}
+
+///
+/// Accumulate lit time for one interval of constant shift register state
+///
+static void accumulate595(struct led_sim_view* view, uint8_t seg, unsigned long dig, unsigned long usec)
+{
+    for (uint8_t d = 0; d < view->digits; ++d)
+    {
+        if (!(dig & (1UL << d)))
+            continue;
+        view->digitOn[d] += usec;
+        for (uint8_t s = 0; s < SEGMENTS; ++s)
+        {
+            if (seg & (1 << s))
+                view->segOn[d][s] += usec;
+        }
+    }
+}
+
+///
+/// Reconstruct the perceived display driven through 74HC595 shift
+/// registers (LED595) over a time window of the bus log.
+/// @param  view    Returns the reconstructed display
+/// @param  conf    COMMON_ANODE or COMMON_CATHODE as passed to LED595
+/// @param  digits  Number of digits
+/// @param  from    Start time in microseconds (inclusive)
+/// @param  to      End time in microseconds (exclusive)
+///
+void LED_SimView595(struct led_sim_view* view, enum led_config conf, uint8_t digits,
+                    unsigned long from, unsigned long to)
+{
+    unsigned long count;
+    const struct led_host_packet* bus = LED_HostBus(&count);
+    const uint8_t digOff = (conf & DIG_INVERT) ? 0xFF : 0x00;
+    const uint8_t segOff = (conf & SEG_INVERT) ? 0xFF : 0x00;
+    // Digit bytes (highest digits first) then the segment byte
+    const uint8_t digBytes = (uint8_t)((digits + 7) / 8);
+    unsigned long dig = 0;
+    uint8_t seg = 0;
+    unsigned long now = from;
+
+    clearView(view, digits, to - from);
+    for (unsigned long i = 0; i < count && bus[i].usec < to; ++i)
+    {
+        if (bus[i].count != digBytes + 1)
+            continue;
+        if (bus[i].usec > now)
+        {
+            accumulate595(view, seg, dig, bus[i].usec - now);
+            now = bus[i].usec;
+        }
+        dig = 0;
+        for (uint8_t b = 0; b < digBytes; ++b)
+            dig = (dig << 8) | (uint8_t)(bus[i].data[b] ^ digOff);
+        seg = bus[i].data[digBytes] ^ segOff;
+    }
+    if (to > now)
+        accumulate595(view, seg, dig, to - now);
+    perceive(view);
+}
+
+///
+/// Set a view to a static (controller driven) display
+///
+static void staticView(struct led_sim_view* view, const uint8_t* seg, uint8_t digits, boolean on)
+{
+    clearView(view, digits, 1);
+    for (uint8_t d = 0; d < digits; ++d)
+    {
+        view->digitOn[d] = on ? 1 : 0;
+        for (uint8_t s = 0; s < SEGMENTS; ++s)
+        {
+            if (on && (seg[d] & (1 << s)))
+                view->segOn[d][s] = 1;
+        }
+    }
+    perceive(view);
+}
+
+///
+/// Reconstruct the display shown by a MAX7219 (LEDMax7219) from the
+/// register writes in the bus log.
+/// @param  view    Returns the display
+/// @param  digits  Number of digits
+///
+void LED_SimDecodeMax7219(struct led_sim_view* view, uint8_t digits)
+{
+    unsigned long count;
+    const struct led_host_packet* bus = LED_HostBus(&count);
+    uint8_t seg[MAX_DIGITS] = { 0 };
+    boolean on = false;
+
+    // One register pair per chained controller, the last controller first
+    const uint8_t chips = (uint8_t)((digits + 7) / 8);
+    for (unsigned long i = 0; i < count; ++i)
+    {
+        if (bus[i].count != 2 * chips)
+            continue;
+        for (uint8_t c = 0; c < chips; ++c)
+        {
+            const uint8_t reg = bus[i].data[2 * (chips - 1 - c)];
+            const uint8_t data = bus[i].data[2 * (chips - 1 - c) + 1];
+            if (reg >= MAX7219_DIGIT0 && reg < MAX7219_DIGIT0 + 8 && c * 8 + reg - MAX7219_DIGIT0 < (int) MAX_DIGITS)
+            {
+                // DP,A..G (bit 7..0) back to enum led_seg order
+                uint8_t bits = data & SEG_DP;
+                for (uint8_t s = 0; s < 7; ++s)
+                {
+                    if (data & (SEG_G >> s))
+                        bits |= (uint8_t)(1 << s);
+                }
+                seg[c * 8 + reg - MAX7219_DIGIT0] = bits;
+            }
+            else if (reg == MAX7219_SHUTDOWN)
+            {
+                on = data & 1;
+            }
+        }
+    }
+    staticView(view, seg, digits, on);
+}
+
+///
+/// Reconstruct the display shown by a TM1637 (LEDTm1637) from the commands
+/// in the bus log.
+/// @param  view    Returns the display
+/// @param  digits  Number of digits
+///
+void LED_SimDecodeTm1637(struct led_sim_view* view, uint8_t digits)
+{
+    unsigned long count;
+    const struct led_host_packet* bus = LED_HostBus(&count);
+    uint8_t seg[MAX_DIGITS] = { 0 };
+    boolean on = false;
+
+    for (unsigned long i = 0; i < count; ++i)
+    {
+        if (bus[i].count == 0)
+            continue;
+        const uint8_t cmd = bus[i].data[0];
+        if ((cmd & 0xC0) == TM1637_ADDRESS)
+        {
+            for (uint8_t n = 1; n < bus[i].count; ++n)
+            {
+                uint8_t d = (uint8_t)((cmd & 0x07) + n - 1);
+                if (d < MAX_DIGITS)
+                    seg[d] = bus[i].data[n];
+            }
+        }
+        else if ((cmd & 0xC0) == TM1637_DISPLAY_OFF)
+        {
+            on = (cmd & 0x08) != 0;
+        }
+    }
+    staticView(view, seg, digits, on);
+}
+
+///
+/// Render a reconstructed display as ASCII-art digits followed by the
+/// percentage of the window each digit was on.
+/// @param  out     Output stream
+/// @param  view    Reconstructed display
+///
+void LED_SimPrint(FILE* out, const struct led_sim_view* view)
+{
+    for (uint8_t row = 0; row < 3; ++row)
+    {
+        for (uint8_t d = 0; d < view->digits; ++d)
+        {
+            const uint8_t seg = view->seg[d];
+            char cell[5] = "    ";
+            if (row == 0)
+            {
+                cell[1] = (seg & SEG_A) ? '_' : ' ';
+            }
+            else if (row == 1)
+            {
+                cell[0] = (seg & SEG_F) ? '|' : ' ';
+                cell[1] = (seg & SEG_G) ? '_' : ' ';
+                cell[2] = (seg & SEG_B) ? '|' : ' ';
+            }
+            else
+            {
+                cell[0] = (seg & SEG_E) ? '|' : ' ';
+                cell[1] = (seg & SEG_D) ? '_' : ' ';
+                cell[2] = (seg & SEG_C) ? '|' : ' ';
+                cell[3] = (seg & SEG_DP) ? '.' : ' ';
+            }
+            fputs(cell, out);
+        }
+        fputc('\n', out);
+    }
+    for (uint8_t d = 0; d < view->digits; ++d)
+    {
+        unsigned long pct = view->span ? (view->digitOn[d] * 100 + view->span / 2) / view->span : 0;
+        fprintf(out, "%3lu%%", pct);
+    }
+    fputc('\n', out);
+}
+
+#endif
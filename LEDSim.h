@@ -0,0 +1,53 @@
+#ifndef LED_SIM_H_FILE
+#define LED_SIM_H_FILE
+///
+/// @file LEDSim.h
+///
+/// Host display simulator.  Reconstructs what a multiplexed display looks
+/// like from the register trace recorded by LEDHost (including how long
+/// each digit and segment was lit) and renders it as ASCII-art digits:
+///
+///      _     _  _
+///     | |  | _| _|
+///     |_|. ||_  _|
+///      25% 25% 25% 25%
+///
+/// Displays driven through an output backend (LEDDrivers.h) are decoded
+/// from the serial bus log instead.
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "LED7Seg.h"
+#include <stdio.h>
+
+/*!
+ *  @ingroup Types
+ *  @brief Perceived display reconstructed from the register trace
+ */
+struct led_sim_view
+{
+    unsigned long span;                         //!< Window length in microseconds
+    uint8_t digits;                             //!< Number of digits
+    unsigned long digitOn[MAX_DIGITS];          //!< Time each digit pin was on
+    unsigned long segOn[MAX_DIGITS][SEGMENTS];  //!< Time each segment of each digit was lit
+    enum led_seg seg[MAX_DIGITS];               //!< Segments perceived as lit
+};
+
+void LED_SimView(struct led_sim_view* view, enum led_config conf, uint8_t digits,
+                 const uint8_t* pins, unsigned long from, unsigned long to);
+void LED_SimView595(struct led_sim_view* view, enum led_config conf, uint8_t digits,
+                    unsigned long from, unsigned long to);
+void LED_SimDecodeMax7219(struct led_sim_view* view, uint8_t digits);
+void LED_SimDecodeTm1637(struct led_sim_view* view, uint8_t digits);
+void LED_SimPrint(FILE* out, const struct led_sim_view* view);
+
+#endif
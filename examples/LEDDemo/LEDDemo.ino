@@ -57,21 +57,20 @@ void loop()
         ++counter;
         if (counter < 64)
         {
-            int8_t segment = counter & 7;
-            int8_t digit = (counter / 8) % LED_DIGITS;
-            for (uint8_t d = 0; d < LED_DIGITS; ++d)
-            {
-                enum led_seg raw[LED_DIGITS];
-                raw[d] = (enum led_seg)((d == digit) ?
-                    ((SEG_B << segment) - 1) : SEG_NONE);
-                led7seg.showRaw(raw);
-            }
+#if LED_PLAYER
+            // Played by refreshSegments() until the next show*() call
+            if (counter == 1)
+                led7seg.showAnimation(ANIM_SEGMENT_WALK, 100);
+#endif
         }
         else if (counter < 200)
         {
-            static const char banner[] = "The Quick Brown Fox Jumped Over The Lazy Dogs 0123456789.";
-            const int scroll = ((counter - 64) >> 1) %  (sizeof(banner) - LED_DIGITS);
-            led7seg.showText(banner + scroll);
+#if LED_PLAYER
+            // Scrolled by refreshSegments() until the next show*() call
+            // (library built with LED_PLAYER=1)
+            if (counter == 64)
+                led7seg.showMarquee(F("The Quick Brown Fox Jumped Over The Lazy Dogs 0123456789."), 200);
+#endif
         }
         else if (counter < 300)
         {
@@ -71,6 +71,9 @@ void setup()
     pinMode(MODE_PIN, INPUT_PULLUP);
 
     led7seg.begin(COMMON_CATHODE, LED_DIGITS, ledPins);
+    // Refresh from Timer2 (Servo uses Timer1) when built with LED_TIMER=2,
+    // otherwise refreshSegments() below keeps polling from loop()
+    led7seg.attachTimer(SCAN_SEGMENTS, 1000);
     analogReference(DEFAULT);
 	  pinMode(LED_BUILTIN, OUTPUT);
     pinMode(A6, INPUT);       // No pullup for A6
@@ -101,19 +104,6 @@ int16_t battery = 0;
 
 static unsigned long ten_msec = millis();
 
-void LED_test()
-{
-    int8_t segment = counter & 7;
-    int8_t digit = (counter / 8) % LED_DIGITS;
-    for (uint8_t d = 0; d < LED_DIGITS; ++d)
-    {
-        enum led_seg raw[LED_DIGITS];
-        raw[d] = (enum led_seg)((d == digit) ?
-            ((SEG_B << segment) - 1) : SEG_NONE);
-        led7seg.showRaw(raw);
-    }
-}
-
 typedef enum disp_mode_t
 {
   BATTERY, POWER, ANALOG, LED_TEST, NUM_MODES
@@ -122,6 +112,10 @@ typedef enum disp_mode_t
 #define SECONDS     10        // counts per second
 
 DISP_MODE dispMode = BATTERY;
+int16_t setpoint = 0;         // Power last shown
+uint8_t adjusting = 0;        // Counts until the setpoint stops flashing
+
+#define DIG_ALL   ((enum led_dig)((1 << LED_DIGITS) - 1))
 
 void loop()
 {
@@ -153,6 +147,10 @@ void loop()
     {
        dispMode = (DISP_MODE) ((dispMode + 1) % NUM_MODES);
        counter = 0;
+       adjusting = 0;
+#if LED_BLINK
+       led7seg.setBlink(DIG_NONE);
+#endif
     }
     oldMode = mode_pin;
 
@@ -181,6 +179,18 @@ void loop()
     case POWER:
       // Display encoder value as signed -x.yy
       led7seg.showDecimal(power, 2);
+#if LED_BLINK
+      // Flash the setpoint while it is being adjusted (library built with
+      // LED_BLINK=1); the refresh does the blinking and each change
+      // restarts it in the visible phase
+      if (power != setpoint) {
+        setpoint = power;
+        adjusting = 2*SECONDS;
+        led7seg.setBlink(DIG_ALL, 250);
+      } else if (adjusting && --adjusting == 0) {
+        led7seg.setBlink(DIG_NONE);
+      }
+#endif
       break;
     case ANALOG:
       // Display analog input as decimal
@@ -188,7 +198,12 @@ void loop()
       led7seg.showDecimal(analogin, 0);
       break;
     default:
-      LED_test();
+#if LED_PLAYER
+      // Segment test is played by the refresh until the mode changes
+      // (library built with LED_PLAYER=1)
+      if (counter == 0)
+        led7seg.showAnimation(ANIM_SEGMENT_WALK, 100);
+#endif
       if (counter >= 3*SECONDS) {
         dispMode = BATTERY;
         counter = 0;
@@ -0,0 +1,118 @@
+//
+// LED7Seg benchNumber Example
+//
+// Copyright (C) 2016 Lennie Araki. All rights reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This example compares the cycle count of showNumber() against the
+// previous division based conversion (% 10 and / 10 per digit) for
+// 1 to 8 digits with and without a decimal point.  Cycles are counted
+// with Timer1 running at the CPU clock (AVR only).  Results are printed
+// as CSV:
+//
+//     digits,dp,div_cycles,show_cycles,match
+//
+#include "LED7Seg.h"
+
+// Access the drawing buffer to check the results match
+class BenchSeg : public SevSeg
+{
+public:
+    const enum led_seg* buffer() { return m_buf; }
+};
+
+BenchSeg led7seg;        //Instantiate LED7Seg object
+
+const byte ledPins[] = { /*segA-F+DP=*/ 5, 9, A2, A4, A5, 6, A1, A3,
+                         /*dig1-8=*/ 4, 7, 8, A0, 2, 3, 10, 11};
+
+enum led_seg ref[MAX_DIGITS];
+
+// Previous showNumber() conversion using 32-bit division
+void divNumber(uint8_t digits, unsigned long num, uint8_t dp, enum led_seg fill)
+{
+    uint8_t d = 0;
+    while (d < digits)
+    {
+        uint8_t mask = pgm_read_byte_near(LED_HexFont + (num % 10));
+        uint8_t index = digits - d - 1;
+        ref[index] = (enum led_seg)((d == dp) ? (mask | SEG_DP) : mask);
+        ++d;
+        num = num / 10;
+        if (num == 0 && d > dp)
+        {
+            while (d < digits)
+            {
+                uint8_t index = digits - d - 1;
+                ref[index] = (enum led_seg)((d == dp) ? (fill | SEG_DP) : fill);
+                ++d;
+                if (fill != LED_0)
+                {
+                    fill = LED_BLANK;
+                }
+            }
+        }
+    }
+}
+
+void setup()
+{
+    Serial.begin(57600);
+    Serial.println(F("digits,dp,div_cycles,show_cycles,match"));
+
+    // Timer1 counts CPU cycles
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+
+    unsigned long num = 9;
+    for (uint8_t digits = 1; digits <= MAX_DIGITS; ++digits)
+    {
+        led7seg.begin(COMMON_CATHODE, digits, ledPins);
+        for (uint8_t pass = 0; pass < 2; ++pass)
+        {
+            const uint8_t dp = pass ? 1 : -1;
+            uint16_t start, divCycles, showCycles;
+
+            noInterrupts();
+            start = TCNT1;
+            divNumber(digits, num, dp, LED_BLANK);
+            divCycles = TCNT1 - start;
+            start = TCNT1;
+            led7seg.showNumber(num, dp, LED_BLANK);
+            showCycles = TCNT1 - start;
+            interrupts();
+
+            boolean match = true;
+            for (uint8_t d = 0; d < digits; ++d)
+            {
+                if (ref[d] != led7seg.buffer()[d])
+                    match = false;
+            }
+            Serial.print(digits);
+            Serial.print(',');
+            Serial.print(pass);
+            Serial.print(',');
+            Serial.print(divCycles);
+            Serial.print(',');
+            Serial.print(showCycles);
+            Serial.print(',');
+            Serial.println(match);
+        }
+        // All 9s is the worst case for both conversions
+        num = num * 10 + 9;
+    }
+}
+
+void loop()
+{
+}
@@ -0,0 +1,111 @@
+//
+// LED7Seg benchPrint Example
+//
+// Copyright (C) 2016 Lennie Araki. All rights reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This example compares the cycle count of LEDPrint::print(double) with
+// formatting the number as text first (dtostrf() or sprintf()) and
+// printing the text.  Cycles are counted with Timer1 running at the CPU
+// clock (AVR only).  Results are printed as CSV:
+//
+//     value,decimals,ledprint_cycles,text_cycles,match
+//
+// For the flash cost, build with BENCH_TEXT set to each value and
+// compare the sketch sizes:
+//
+//     0   LEDPrint fixed-point formatter only (text_cycles = 0)
+//     1   dtostrf() (avr-libc)
+//     2   sprintf("%.*f") (needs -Wl,-u,vfprintf -lprintf_flt, otherwise
+//         the Arduino default printf prints '?' for floats)
+//
+#include "LED7Seg.h"
+#include "LEDPrint.h"
+
+#define BENCH_TEXT      1
+
+// Access the display page to check the results match
+class BenchSeg : public SevSeg
+{
+public:
+    const enum led_seg* front() { return m_page[m_front].buf; }
+};
+
+BenchSeg led7seg;        //Instantiate LED7Seg object
+LEDPrint lcd(led7seg);
+
+const byte ledPins[] = { /*segA-F+DP=*/ 5, 9, A2, A4, A5, 6, A1, A3, /*dig1-4=*/ 4, 7, 8, A0};
+
+const float values[] = { 0.0, 1.5, -3.14159, 12.34, 99.95, -0.25, 456.7, 1234.0 };
+
+void setup()
+{
+    Serial.begin(57600);
+    Serial.println(F("value,decimals,ledprint_cycles,text_cycles,match"));
+    led7seg.begin(COMMON_CATHODE, 4, ledPins);
+
+    // Timer1 counts CPU cycles
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+
+    for (uint8_t i = 0; i < sizeof(values) / sizeof(values[0]); ++i)
+    {
+        for (uint8_t dp = 0; dp < 3; ++dp)
+        {
+            enum led_seg ref[4];
+            char text[16];
+            uint16_t start, printCycles, textCycles = 0;
+
+            noInterrupts();
+#if BENCH_TEXT
+            start = TCNT1;
+#if BENCH_TEXT == 1
+            dtostrf(values[i], 0, dp, text);
+#else
+            sprintf(text, "%.*f", dp, values[i]);
+#endif
+            lcd.println(text);
+            textCycles = TCNT1 - start;
+#else
+            (void) text;
+#endif
+            for (uint8_t d = 0; d < 4; ++d)
+                ref[d] = led7seg.front()[d];
+            start = TCNT1;
+            lcd.print(values[i], dp);
+            printCycles = TCNT1 - start;
+            lcd.println();
+            interrupts();
+
+            boolean match = true;
+            for (uint8_t d = 0; d < 4; ++d)
+            {
+                if (ref[d] != led7seg.front()[d])
+                    match = false;
+            }
+            Serial.print(values[i], 5);
+            Serial.print(',');
+            Serial.print(dp);
+            Serial.print(',');
+            Serial.print(printCycles);
+            Serial.print(',');
+            Serial.print(textCycles);
+            Serial.print(',');
+            Serial.println(BENCH_TEXT ? match : true);
+        }
+    }
+}
+
+void loop()
+{
+}
@@ -0,0 +1,116 @@
+//
+// LED7Seg benchRefresh Example
+//
+// Copyright (C) 2016 Lennie Araki. All rights reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This example measures the per-tick cost of the segment scan.  It
+// compares building the digit mask by testing every buffer entry (the
+// previous refreshSegments() loop) with the bitplane lookup, and reports
+// the total scanSegments() and scanDigits() cost per tick.  Cycles are
+// counted with Timer1 running at the CPU clock (AVR only).  Results are
+// printed as CSV:
+//
+//     step,min_cycles,max_cycles
+//
+#include "LED7Seg.h"
+
+// Access the display pages to time the digit mask lookups
+class BenchSeg : public SevSeg
+{
+public:
+    const struct led_page* front() { return &m_page[m_front]; }
+};
+
+BenchSeg led7seg;        //Instantiate LED7Seg object
+#define LED_DIGITS      4
+
+//        D1  A  F D2 D3  B
+//      +--o--o--o--o--o--o--+
+//      | D4 D5 D6 D7 D8 D9  |
+//      |    Arduino Nano    |
+//      | A5 A4 A3 A2 A1 A0  |
+//      +--o--o--o--o--o--o--+
+//         E  D DP  C  G D4
+const byte ledPins[] = { /*segA-F+DP=*/ 5, 9, A2, A4, A5, 6, A1, A3, /*dig1-4=*/ 4, 7, 8, A0};
+
+volatile uint8_t sink;
+
+void report(const __FlashStringHelper* step, uint16_t minCycles, uint16_t maxCycles)
+{
+    Serial.print(step);
+    Serial.print(',');
+    Serial.print(minCycles);
+    Serial.print(',');
+    Serial.println(maxCycles);
+}
+
+void setup()
+{
+    Serial.begin(57600);
+    Serial.println(F("step,min_cycles,max_cycles"));
+    led7seg.begin(COMMON_CATHODE, LED_DIGITS, ledPins);
+    led7seg.showText("8.8.8.8.");
+
+    // Timer1 counts CPU cycles
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+
+    uint16_t lo[4] = { 0xFFFF, 0xFFFF, 0xFFFF, 0xFFFF };
+    uint16_t hi[4] = { 0, 0, 0, 0 };
+    for (uint8_t s = 0; s < SEGMENTS; ++s)
+    {
+        uint16_t start, cycles[4];
+        const struct led_page* page = led7seg.front();
+        const uint8_t segMask = SEG_A << s;
+
+        noInterrupts();
+        // Previous digit mask: test every buffer entry
+        start = TCNT1;
+        uint8_t digitMask = DIG_NONE;
+        for (uint8_t dig = 0; dig < MAX_DIGITS; ++dig)
+        {
+            if (page->buf[dig] & segMask)
+                digitMask |= DIG_0 << dig;
+        }
+        sink = digitMask;
+        cycles[0] = TCNT1 - start;
+        // Bitplane lookup
+        start = TCNT1;
+        sink = page->planes[s];
+        cycles[1] = TCNT1 - start;
+        start = TCNT1;
+        led7seg.scanSegments();
+        cycles[2] = TCNT1 - start;
+        start = TCNT1;
+        led7seg.scanDigits();
+        cycles[3] = TCNT1 - start;
+        interrupts();
+
+        for (uint8_t i = 0; i < 4; ++i)
+        {
+            if (cycles[i] < lo[i])
+                lo[i] = cycles[i];
+            if (cycles[i] > hi[i])
+                hi[i] = cycles[i];
+        }
+    }
+    report(F("digit_mask_loop"), lo[0], hi[0]);
+    report(F("digit_mask_plane"), lo[1], hi[1]);
+    report(F("scanSegments"), lo[2], hi[2]);
+    report(F("scanDigits"), lo[3], hi[3]);
+}
+
+void loop()
+{
+}
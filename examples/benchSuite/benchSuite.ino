@@ -0,0 +1,234 @@
+//
+// LED7Seg benchSuite Example
+//
+// Copyright (C) 2016 Lennie Araki. All rights reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This example measures the cycle count of the public drawing and refresh
+// methods over a set of inputs, and the footprint of the sketch.  Cycles
+// are counted with Timer1 running at the CPU clock with interrupts off,
+// less the cost of reading the timer, so results are exact under a
+// simulator.  Results are printed as CSV:
+//
+//     bench,calls,min_cycles,max_cycles,avg_cycles
+//     footprint,bytes
+//
+// Run it on an ATmega328P or under simavr, which prints the serial output
+// and exits when the sketch goes to sleep at the end:
+//
+//     arduino-cli compile -b arduino:avr:nano --output-dir build examples/benchSuite
+//     simavr -m atmega328p -f 16000000 build/benchSuite.ino.elf
+//
+// Flash per function: avr-nm -C --size-sort -t d build/benchSuite.ino.elf
+//
+#include "LED7Seg.h"
+#include <avr/sleep.h>
+
+// Force the polled refresh methods to scan on every call
+class BenchSeg : public SevSeg
+{
+public:
+    void expire() { m_last = millis() - 1; }
+};
+
+BenchSeg led7seg;        //Instantiate LED7Seg object
+#define LED_DIGITS      4
+
+//        D1  A  F D2 D3  B
+//      +--o--o--o--o--o--o--+
+//      | D4 D5 D6 D7 D8 D9  |
+//      |    Arduino Nano    |
+//      | A5 A4 A3 A2 A1 A0  |
+//      +--o--o--o--o--o--o--+
+//         E  D DP  C  G D4
+const byte ledPins[] = { /*segA-F+DP=*/ 5, 9, A2, A4, A5, 6, A1, A3, /*dig1-4=*/ 4, 7, 8, A0};
+
+// Linker symbols for the footprint
+extern char __data_start, __data_end, __bss_start, __bss_end, __data_load_end;
+
+const char* const texts[] = { "8.8.8.8.", "bAtt", "Err", "12.5", "    ", "HELLO" };
+const enum led_seg raws[][LED_DIGITS] =
+{
+    { SEG_NONE, SEG_NONE, SEG_NONE, SEG_NONE },
+    { LED_8, LED_8, LED_8, LED_8 },
+    { SEG_A, SEG_B, SEG_C, SEG_D },
+    { (enum led_seg) 0xFF, (enum led_seg) 0xFF, (enum led_seg) 0xFF, (enum led_seg) 0xFF },
+};
+
+uint16_t overhead;
+
+/// Running cycle statistics for one benchmark
+struct bench
+{
+    uint16_t calls;
+    uint16_t lo;
+    uint16_t hi;
+    uint32_t sum;
+};
+
+void benchStart(struct bench* b)
+{
+    b->calls = 0;
+    b->lo = 0xFFFF;
+    b->hi = 0;
+    b->sum = 0;
+}
+
+void benchAdd(struct bench* b, uint16_t start, uint16_t end)
+{
+    const uint16_t cycles = end - start - overhead;
+    ++b->calls;
+    b->sum += cycles;
+    if (cycles < b->lo)
+        b->lo = cycles;
+    if (cycles > b->hi)
+        b->hi = cycles;
+}
+
+void report(const __FlashStringHelper* name, const struct bench* b)
+{
+    Serial.print(name);
+    Serial.print(',');
+    Serial.print(b->calls);
+    Serial.print(',');
+    Serial.print(b->lo);
+    Serial.print(',');
+    Serial.print(b->hi);
+    Serial.print(',');
+    Serial.println(b->calls ? b->sum / b->calls : 0);
+}
+
+void footprint(const __FlashStringHelper* name, uint16_t bytes)
+{
+    Serial.print(name);
+    Serial.print(',');
+    Serial.println(bytes);
+}
+
+// Time one statement with interrupts off
+#define BENCH(b, stmt)                  \
+    do {                                \
+        noInterrupts();                 \
+        const uint16_t t0 = TCNT1;      \
+        stmt;                           \
+        const uint16_t t1 = TCNT1;      \
+        interrupts();                   \
+        benchAdd(&(b), t0, t1);         \
+    } while (0)
+
+void setup()
+{
+    struct bench b;
+
+    Serial.begin(57600);
+    led7seg.begin(COMMON_CATHODE, LED_DIGITS, ledPins);
+
+    // Timer1 counts CPU cycles
+    TCCR1A = 0;
+    TCCR1B = _BV(CS10);
+    noInterrupts();
+    const uint16_t t0 = TCNT1;
+    const uint16_t t1 = TCNT1;
+    interrupts();
+    overhead = t1 - t0;
+
+    Serial.println(F("bench,calls,min_cycles,max_cycles,avg_cycles"));
+
+    benchStart(&b);
+    for (uint16_t m = 0; m < 256; ++m)
+        BENCH(b, led7seg.setSegments((enum led_seg) m));
+    report(F("setSegments"), &b);
+
+    benchStart(&b);
+    for (uint8_t m = 0; m < (1 << LED_DIGITS); ++m)
+        BENCH(b, led7seg.setDigits((enum led_dig) m));
+    report(F("setDigits"), &b);
+
+    benchStart(&b);
+    for (uint16_t i = 0; i < 64; ++i)
+        BENCH(b, led7seg.showHex(i * 0x0411UL));
+    report(F("showHex"), &b);
+
+    benchStart(&b);
+    unsigned long num = 0;
+    for (uint8_t i = 0; i < 64; ++i)
+    {
+        BENCH(b, led7seg.showNumber(num, i & 3));
+        num = num * 3 + 7;
+    }
+    report(F("showNumber"), &b);
+
+    benchStart(&b);
+    for (int i = -9999; i <= 9999; i += 317)
+        BENCH(b, led7seg.showDecimal(i, 1));
+    report(F("showDecimal"), &b);
+
+    benchStart(&b);
+    for (uint8_t i = 0; i < sizeof(texts) / sizeof(texts[0]); ++i)
+        BENCH(b, led7seg.showText(texts[i]));
+    report(F("showText"), &b);
+
+    benchStart(&b);
+    for (uint8_t i = 0; i < sizeof(raws) / sizeof(raws[0]); ++i)
+        BENCH(b, led7seg.showRaw(raws[i]));
+    report(F("showRaw"), &b);
+
+    // Refresh: a full scan cycle for each text, then the idle path
+    struct bench idle;
+    benchStart(&b);
+    benchStart(&idle);
+    for (uint8_t i = 0; i < sizeof(texts) / sizeof(texts[0]); ++i)
+    {
+        led7seg.showText(texts[i]);
+        for (uint8_t s = 0; s < MAX_DIGITS; ++s)
+        {
+            led7seg.expire();
+            BENCH(b, led7seg.refreshDigits());
+            BENCH(idle, led7seg.refreshDigits());
+        }
+    }
+    report(F("refreshDigits"), &b);
+    report(F("refreshDigits_idle"), &idle);
+
+    benchStart(&b);
+    benchStart(&idle);
+    for (uint8_t i = 0; i < sizeof(texts) / sizeof(texts[0]); ++i)
+    {
+        led7seg.showText(texts[i]);
+        for (uint8_t s = 0; s < SEGMENTS; ++s)
+        {
+            led7seg.expire();
+            BENCH(b, led7seg.refreshSegments());
+            BENCH(idle, led7seg.refreshSegments());
+        }
+    }
+    report(F("refreshSegments"), &b);
+    report(F("refreshSegments_idle"), &idle);
+
+    Serial.println(F("footprint,bytes"));
+    footprint(F("flash"), (uint16_t) &__data_load_end);
+    footprint(F("data"), (uint16_t)(&__data_end - &__data_start));
+    footprint(F("bss"), (uint16_t)(&__bss_end - &__bss_start));
+    footprint(F("sizeof_SevSeg"), sizeof(SevSeg));
+    Serial.flush();
+
+    // Sleeping with interrupts off ends a simavr run
+    cli();
+    set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+    sleep_enable();
+    sleep_cpu();
+}
+
+void loop()
+{
+}
@@ -0,0 +1,61 @@
+//
+// LED7Seg keypad Example
+//
+// Copyright (C) 2016 Lennie Araki. All rights reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This example scans up to 8 keys on the digit lines of the display, the
+// way LED driver chips with a key matrix do.  Each key connects a digit
+// line to a return pin (D2 or D3) through a diode, cathode to the digit
+// line.  The display refresh drives one digit line in a key slot every
+// 8 ms and queues debounced presses and releases; loop() shows the
+// number of the last key pressed.
+//
+//     Key 0-3: digit 1-4 lines to D2
+//     Key 8-11: digit 1-4 lines to D3
+//
+// Build the library with LED_KEYS=1.
+//
+#include "LED7Seg.h"
+
+SevSeg led7seg;        //Instantiate LED7Seg object
+#define LED_DIGITS      4
+
+//        D1  A  F D2 D3  B
+//      +--o--o--o--o--o--o--+
+//      | D4 D5 D6 D7 D8 D9  |
+//      |    Arduino Nano    |
+//      | A5 A4 A3 A2 A1 A0  |
+//      +--o--o--o--o--o--o--+
+//         E  D DP  C  G D4
+const byte ledPins[] = { /*segA-F+DP=*/ 5, 9, A2, A4, A5, 6, A1, A3, /*dig1-4=*/ 4, 7, 8, A0};
+const byte keyPins[] = { 2, 3 };
+
+void setup()
+{
+    led7seg.begin(COMMON_CATHODE, LED_DIGITS, ledPins);
+    led7seg.setKeypad(keyPins, 2, (enum led_dig)(DIG_0 | DIG_1 | DIG_2 | DIG_3));
+    led7seg.showText("----");
+}
+
+void loop()
+{
+    uint8_t key;
+    while ((key = led7seg.readKey()) != KEY_NONE)
+    {
+        if (key & KEY_UP)
+            continue;
+        led7seg.showNumber(key, -1);
+    }
+    led7seg.refreshDigits(); // Refresh/multiplex display, scan keys
+}
@@ -0,0 +1,69 @@
+//
+// LED7Seg lowPower Example
+//
+// Copyright (C) 2016 Lennie Araki. All rights reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This example shows a count of button presses on D2 for a battery
+// powered unit.  The display is refreshed by the timer and loop() sleeps
+// between interrupts.  After 10 seconds without a new count the scan rate
+// drops to 250 Hz, after 60 seconds the display is turned off, and the
+// next press shows the count again at once.
+//
+// Build the library with LED_POWER=1 and LED_TIMER=1 or 2; without a
+// timer the display is polled and power save is not available.
+//
+#include "LED7Seg.h"
+
+SevSeg led7seg;        //Instantiate LED7Seg object
+#define LED_DIGITS      4
+#define BUTTON_PIN      2
+
+//        D1  A  F D2 D3  B
+//      +--o--o--o--o--o--o--+
+//      | D4 D5 D6 D7 D8 D9  |
+//      |    Arduino Nano    |
+//      | A5 A4 A3 A2 A1 A0  |
+//      +--o--o--o--o--o--o--+
+//         E  D DP  C  G D4
+const byte ledPins[] = { /*segA-F+DP=*/ 5, 9, A2, A4, A5, 6, A1, A3, /*dig1-4=*/ 4, 7, 8, A0};
+
+boolean timed;
+
+void setup()
+{
+    pinMode(BUTTON_PIN, INPUT_PULLUP);
+    led7seg.begin(COMMON_CATHODE, LED_DIGITS, ledPins);
+    timed = led7seg.attachTimer(SCAN_DIGITS, 1000);
+    led7seg.setPowerSave(10, 60, 250);
+    led7seg.showNumber(0, -1);
+}
+
+void loop()
+{
+    static uint8_t oldButton = HIGH;
+    static unsigned int count = 0;
+
+    const uint8_t button = digitalRead(BUTTON_PIN);
+    if (button == LOW && oldButton == HIGH)
+    {
+        // Showing the count also wakes the display
+        led7seg.showNumber(++count, -1);
+    }
+    oldButton = button;
+
+    if (timed)
+        SevSeg::idle();     // Sleep until the next timer or millis() tick
+    else
+        led7seg.refreshDigits();
+}
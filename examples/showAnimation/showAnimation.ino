@@ -0,0 +1,77 @@
+//
+// LED7Seg showAnimation Example
+//
+// Copyright (C) 2016 Lennie Araki. All rights reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This example demonstrates the showAnimation() function of the LED7Seg
+// library.  At startup it shows a lamp test, then plays a flash animation
+// with its own frame durations, then a spinner.  The frames are played by
+// refreshSegments(), so loop() does no work per frame.
+//
+// Build the library with LED_PLAYER=1.
+//
+#include "LED7Seg.h"
+
+SevSeg led7seg;        //Instantiate LED7Seg object
+#define LED_DIGITS      4
+
+//        D1  A  F D2 D3  B
+//      +--o--o--o--o--o--o--+
+//      | D4 D5 D6 D7 D8 D9  |
+//      |    Arduino Nano    |
+//      | A5 A4 A3 A2 A1 A0  |
+//      +--o--o--o--o--o--o--+
+//         E  D DP  C  G D4
+const byte ledPins[] = { /*segA-F+DP=*/ 5, 9, A2, A4, A5, 6, A1, A3, /*dig1-4=*/ 4, 7, 8, A0};
+
+// Bar growing from the left, then "Go"
+const enum led_seg bootFrames[][LED_DIGITS] PROGMEM =
+{
+    { SEG_G,     SEG_NONE,  SEG_NONE,  SEG_NONE  },
+    { SEG_G,     SEG_G,     SEG_NONE,  SEG_NONE  },
+    { SEG_G,     SEG_G,     SEG_G,     SEG_NONE  },
+    { SEG_G,     SEG_G,     SEG_G,     SEG_G     },
+    { LED_BLANK, LED_G,     LED_o,     LED_BLANK },
+};
+const uint16_t bootTimes[] PROGMEM = { 150, 150, 150, 150, 1000 };
+
+volatile uint8_t stage = 0;
+
+void animationDone(SevSegBase* led)
+{
+    ++stage;
+}
+
+void setup()
+{
+    led7seg.begin(COMMON_CATHODE, LED_DIGITS, ledPins);
+    led7seg.setAnimationDone(animationDone);
+    led7seg.showAnimation(ANIM_ALL_ON, 1000, MARQUEE_ONCE);
+}
+
+void loop()
+{
+    static uint8_t shown = 0;
+
+    if (stage != shown)
+    {
+        shown = stage;
+        if (shown == 1)
+            led7seg.showAnimation(&bootFrames[0][0], 5, bootTimes, MARQUEE_ONCE);
+        else if (shown == 2)
+            led7seg.showAnimation(ANIM_SPINNER, 80);
+    }
+//  led7seg.refreshDigits(); // Refresh/multiplex display
+    led7seg.refreshSegments(); // Refresh/multiplex display
+}
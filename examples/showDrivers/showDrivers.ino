@@ -0,0 +1,54 @@
+//
+// LED7Seg showDrivers Example
+//
+// Copyright (C) 2016 Lennie Araki. All rights reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This example demonstrates driving the display through an output backend
+// instead of 12 direct pins.  Select one backend below:
+//
+//  LED595      Two 74HC595 (segments, then digits) on hardware SPI:
+//              D11=SER, D13=SRCLK, D10=RCLK
+//  LEDMax7219  MAX7219 module on hardware SPI: D11=DIN, D13=CLK, D10=LOAD
+//  LEDTm1637   TM1637 module: D2=CLK, D3=DIO
+//
+#include "LED7Seg.h"
+#include "LEDDrivers.h"
+
+#define LED_DIGITS      4
+
+LED595 ledOut(COMMON_CATHODE, 10);
+//LEDMax7219 ledOut(10);
+//LEDTm1637 ledOut(2, 3);
+
+SevSeg led7seg;        //Instantiate LED7Seg object
+
+void setup()
+{
+    led7seg.begin(&ledOut, LED_DIGITS);
+}
+
+void loop()
+{
+    static unsigned long ten_msec = millis();
+    static int counter = 0;
+
+    if (millis() >= ten_msec) {
+        ten_msec += 100;
+        ++counter;
+        // Display counter in decimal ddd.d
+        led7seg.showDecimal(counter, 1);
+    }
+    // Shift registers are multiplexed by SevSeg; controllers ignore this
+    led7seg.refreshDigits();
+}
@@ -48,13 +48,13 @@ void loop()
         ++counter;
         int8_t segment = counter & 7;
         int8_t digit = (counter / 8) % LED_DIGITS;
+        enum led_seg raw[LED_DIGITS];
         for (uint8_t d = 0; d < LED_DIGITS; ++d)
         {
-            enum led_seg raw[LED_DIGITS];
             raw[d] = (enum led_seg)((d == digit) ?
                 ((SEG_B << segment) - 1) : SEG_NONE);
-            led7seg.showRaw(raw);
         }
+        led7seg.showRaw(raw);
     }
 //  led7seg.refreshDigits(); // Refresh/multiplex display
     led7seg.refreshSegments(); // Refresh/multiplex display
@@ -0,0 +1,54 @@
+//
+// LED7Seg staticPins Example
+//
+// Copyright (C) 2016 Lennie Araki. All rights reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This example demonstrates the SevSegT template of the LED7Seg library.
+// The pins and polarity are template arguments so the refresh path is
+// specialized at compile time (Uno/Nano/Pro Mini only).  Compare the
+// code size with the showHex example which uses the runtime SevSeg class.
+//
+#include "LED7Seg.h"
+
+#define LED_DIGITS      4
+
+//        D1  A  F D2 D3  B
+//      +--o--o--o--o--o--o--+
+//      | D4 D5 D6 D7 D8 D9  |
+//      |    Arduino Nano    |
+//      | A5 A4 A3 A2 A1 A0  |
+//      +--o--o--o--o--o--o--+
+//         E  D DP  C  G D4
+SevSegT<COMMON_CATHODE, LED_DIGITS,
+    /*segA-F+DP=*/ 5, 9, A2, A4, A5, 6, A1, A3, /*dig1-4=*/ 4, 7, 8, A0> led7seg;
+
+void setup()
+{
+    led7seg.begin();
+}
+
+void loop()
+{
+    static unsigned long ten_msec = millis();
+    static int counter = 0;
+    
+    if (millis() >= ten_msec) {
+        ten_msec += 100;
+        ++counter;
+        // Display counter in hex dddd
+        led7seg.showHex(counter);
+    }
+//  led7seg.refreshDigits(); // Refresh/multiplex display
+    led7seg.refreshSegments(); // Refresh/multiplex display
+}
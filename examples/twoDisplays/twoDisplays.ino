@@ -0,0 +1,71 @@
+//
+// LED7Seg twoDisplays Example
+//
+// Copyright (C) 2016 Lennie Araki. All rights reserved
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+// This example refreshes two displays from one timer: the actual value on
+// direct pins and the setpoint on two 74HC595 (D11=SER, D13=SRCLK,
+// D10=RCLK).  The displays take turns on alternate timer ticks, so each
+// is scanned at 1000 slots per second and loop() does no refresh work.
+//
+// Build the library with LED_TIMER=1 or 2 to use the timer; otherwise
+// attachTimer() fails and both displays are polled from loop().
+//
+#include "LED7Seg.h"
+#include "LEDDrivers.h"
+
+#define LED_DIGITS      4
+
+SevSeg actual;         //Direct pin display
+SevSeg setpoint;       //74HC595 display
+LED595 setpointOut(COMMON_CATHODE, 10);
+
+//        D1  A  F D2 D3  B
+//      +--o--o--o--o--o--o--+
+//      | D4 D5 D6 D7 D8 D9  |
+//      |    Arduino Nano    |
+//      | A5 A4 A3 A2 A1 A0  |
+//      +--o--o--o--o--o--o--+
+//         E  D DP  C  G D4
+const byte ledPins[] = { /*segA-F+DP=*/ 5, 9, A2, A4, A5, 6, A1, A3, /*dig1-4=*/ 4, 7, 8, A0};
+
+boolean timed;
+
+void setup()
+{
+    actual.begin(COMMON_CATHODE, LED_DIGITS, ledPins);
+    setpoint.begin(&setpointOut, LED_DIGITS);
+    timed = actual.attachTimer(SCAN_SEGMENTS, 1000) &&
+            setpoint.attachTimer(SCAN_DIGITS, 1000);
+}
+
+void loop()
+{
+    static unsigned long ten_msec = millis();
+    static int value = 0;
+
+    if (millis() >= ten_msec) {
+        ten_msec += 100;
+        // Setpoint from the pot, actual value follows it
+        const int target = analogRead(A6);
+        value += (target - value) / 4;
+        setpoint.showNumber(target, 0);
+        actual.showNumber(value, 0);
+    }
+    if (!timed)
+    {
+        actual.refreshSegments();
+        setpoint.refreshDigits();
+    }
+}
@@ -0,0 +1,98 @@
+///
+/// Host check: the timer interrupt only draws animation steps; update()
+/// commits them.  The animation done callback runs outside the interrupt
+/// (from update(), idle() or the polled refresh) and may show new
+/// content.
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "hostCheck.h"
+
+static const byte ledPins[] = { 5, 9, A2, A4, A5, 6, A1, A3, 4, 7, 8, A0 };
+
+static unsigned s_done;                 // Calls of animationDone()
+
+static void animationDone(SevSegBase* led)
+{
+    ++s_done;
+    led->showText("donE");
+}
+
+///
+/// Get the segments shown on the first digit over the last 20 ms
+///
+static enum led_seg firstDigit(void)
+{
+    struct led_sim_view view;
+    LED_SimView(&view, COMMON_CATHODE, 4, ledPins, micros() - 20000, micros());
+    return view.seg[0];
+}
+
+///
+/// Check that the display shows "donE"
+///
+static void checkShown(void)
+{
+    struct led_sim_view view;
+    LED_SimView(&view, COMMON_CATHODE, 4, ledPins, micros() - 20000, micros());
+    CHECK_EQ(view.seg[0], LED_d);
+    CHECK_EQ(view.seg[3], LED_E);
+}
+
+int main()
+{
+    LED_HostReset();
+    SevSeg led;
+    led.begin(COMMON_CATHODE, 4, ledPins);
+    led.setAnimationDone(animationDone);
+
+    // Timer: the step drawn by the interrupt is shown after update()
+    s_done = 0;
+    CHECK(led.attachTimer(SCAN_DIGITS, 1000));
+    led.showAnimation(ANIM_ALL_ON, 100, MARQUEE_ONCE);
+    LED_HostAdvance(30000);
+    CHECK(led.animationBusy());
+    CHECK_EQ(firstDigit(), SEG_NONE);
+    led.update();
+    LED_HostAdvance(30000);
+    CHECK_EQ(firstDigit(), (enum led_seg) 0xFF);
+
+    // Nothing is called from the interrupt, update() calls it once
+    LED_HostAdvance(300000);
+    CHECK_EQ(s_done, 0);
+    CHECK(!led.animationBusy());
+    led.update();
+    led.update();
+    CHECK_EQ(s_done, 1);
+    LED_HostAdvance(30000);
+    checkShown();
+
+    // Timer with idle(): called after waking up
+    s_done = 0;
+    led.showAnimation(ANIM_ALL_ON, 100, MARQUEE_ONCE);
+    for (uint16_t i = 0; i < 1000 && !s_done; ++i)
+    {
+        SevSeg::idle();
+    }
+    CHECK_EQ(s_done, 1);
+    LED_HostAdvance(30000);
+    checkShown();
+    led.detachTimer();
+
+    // Polled: the refresh calls it
+    s_done = 0;
+    led.showAnimation(ANIM_ALL_ON, 100, MARQUEE_ONCE);
+    runPolled(led, &SevSeg::refreshDigits, 300);
+    CHECK_EQ(s_done, 1);
+    checkShown();
+    return checkDone("checkAnimation");
+}
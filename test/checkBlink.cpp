@@ -0,0 +1,76 @@
+///
+/// Host check: blinking (built with LED_BLINK=1).  Blinking digits show
+/// their content in the on phase and their alternate content in the off
+/// phase; the other digits are not affected.
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "hostCheck.h"
+
+static const byte ledPins[] = { 5, 9, A2, A4, A5, 6, A1, A3, 4, 7, 8, A0 };
+
+///
+/// Check the digits shown during the last 200 ms
+///
+static void checkPhase(enum led_seg d1, enum led_seg d2)
+{
+    struct led_sim_view view;
+    LED_SimView(&view, COMMON_CATHODE, 4, ledPins, micros() - 200000, micros());
+    CHECK_EQ(view.seg[0], LED_1);
+    CHECK_EQ(view.seg[1], d1);
+    CHECK_EQ(view.seg[2], d2);
+    CHECK_EQ(view.seg[3], LED_4);
+}
+
+static void checkBlink(boolean segments, boolean timer)
+{
+    LED_HostReset();
+    SevSeg led;
+    led.begin(COMMON_CATHODE, 4, ledPins);
+    led.showText("1234");
+    if (timer)
+        CHECK(led.attachTimer(segments ? SCAN_SEGMENTS : SCAN_DIGITS, 1000));
+    led.setBlinkContent(2, SEG_DP);
+    led.setBlink((enum led_dig)(DIG_1 | DIG_2), 500);
+    for (uint8_t phase = 0; phase < 4; ++phase)
+    {
+        // checkPhase() looks at the last 200 ms of each phase
+        if (timer)
+        {
+            LED_HostAdvance(500000);
+        }
+        else
+        {
+            runPolled(led, segments ? &SevSeg::refreshSegments : &SevSeg::refreshDigits, 500);
+        }
+        if (phase & 1)
+            checkPhase(SEG_NONE, SEG_DP);
+        else
+            checkPhase(LED_2, LED_3);
+    }
+    led.setBlink(DIG_NONE);
+    if (timer)
+        LED_HostAdvance(300000);
+    else
+        runPolled(led, segments ? &SevSeg::refreshSegments : &SevSeg::refreshDigits, 300);
+    checkPhase(LED_2, LED_3);
+    led.detachTimer();
+}
+
+int main()
+{
+    checkBlink(false, false);
+    checkBlink(true, false);
+    checkBlink(false, true);
+    checkBlink(true, true);
+    return checkDone("checkBlink");
+}
@@ -0,0 +1,70 @@
+///
+/// Host check: brightness modulation under the timer.  Each digit is lit
+/// in proportion to its level, and no timer interval is shorter than
+/// LED_BRIGHT_MIN_US.
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "hostCheck.h"
+
+static const byte ledPins[] = { 5, 9, A2, A4, A5, 6, A1, A3, 4, 7, 8, A0 };
+static const uint8_t levels[4] = { LED_BRIGHT_MAX, 10, 5, 1 };
+
+static void checkLevels(enum led_scan mode, uint16_t hz)
+{
+    LED_HostReset();
+    SevSeg led;
+    led.begin(COMMON_CATHODE, 4, ledPins);
+    led.showText("8888");
+    for (uint8_t d = 0; d < 4; ++d)
+    {
+        led.setDigitBrightness(d, levels[d]);
+    }
+    CHECK(led.attachTimer(mode, hz));
+    LED_HostAdvance(100000);
+    const unsigned long from = micros();
+    LED_HostAdvance(1000000);
+
+    // Lit time in proportion to the level (within 2%)
+    struct led_sim_view view;
+    LED_SimView(&view, COMMON_CATHODE, 4, ledPins, from, micros());
+    for (uint8_t d = 1; d < 4; ++d)
+    {
+        const unsigned long expect = view.digitOn[0] / LED_BRIGHT_MAX * levels[d];
+        CHECK(view.digitOn[d] + expect / 50 >= expect && view.digitOn[d] <= expect + expect / 50);
+    }
+
+    // Every slot (each changes the digit lines) lasts at least the unit
+    unsigned long count;
+    const struct led_host_event* trace = LED_HostTrace(&count);
+    unsigned long last = 0;
+    unsigned long shortest = ~0UL;
+    for (unsigned long i = 0; i < count; ++i)
+    {
+        if (trace[i].usec < from || trace[i].usec == last)
+            continue;
+        if (last >= from && trace[i].usec - last < shortest)
+            shortest = trace[i].usec - last;
+        last = trace[i].usec;
+    }
+    CHECK(shortest >= LED_BRIGHT_MIN_US);
+    led.detachTimer();
+}
+
+int main()
+{
+    checkLevels(SCAN_DIGITS, 1000);
+    checkLevels(SCAN_DIGITS, 2000);
+    checkLevels(SCAN_SEGMENTS, 1000);
+    checkLevels(SCAN_AUTO, 1000);
+    return checkDone("checkBright");
+}
@@ -0,0 +1,137 @@
+///
+/// Host check: output backends (LEDDrivers.h).  LED595 gets one transfer
+/// per scan slot, the controllers get their digit registers once per
+/// commit() and map setBrightness() to their intensity, and LEDSim
+/// rebuilds the display from the bus log.
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "hostCheck.h"
+#include "LEDDrivers.h"
+
+static const enum led_seg digits1234[4] = { LED_1, LED_2, LED_3, LED_4 };
+
+///
+/// Number of serial bus packets recorded so far
+///
+static unsigned long busCount(void)
+{
+    unsigned long count;
+    LED_HostBus(&count);
+    return count;
+}
+
+///
+/// Last serial bus packet
+///
+static const struct led_host_packet* busLast(void)
+{
+    unsigned long count;
+    const struct led_host_packet* bus = LED_HostBus(&count);
+    return count ? &bus[count - 1] : 0;
+}
+
+static void check595(enum led_config conf, boolean segments)
+{
+    LED_HostReset();
+    LED595 out(conf, 10);
+    SevSeg led;
+    led.begin(&out, 4);
+    led.showText("1234");
+    const unsigned long before = busCount();
+    runPolled(led, segments ? &SevSeg::refreshSegments : &SevSeg::refreshDigits, 200);
+    // One 2-byte transfer (digits, then segments) per slot
+    CHECK_EQ(busCount() - before, 200);
+    CHECK_EQ(busLast()->count, 2);
+
+    struct led_sim_view view;
+    LED_SimView595(&view, conf, 4, 100000, 200000);
+    for (uint8_t d = 0; d < 4; ++d)
+    {
+        CHECK_EQ(view.seg[d], digits1234[d]);
+    }
+}
+
+static void checkMax7219(void)
+{
+    LED_HostReset();
+    LEDMax7219 out(10);
+    SevSeg led;
+    led.begin(&out, 4);
+    led.showText("1234");
+    struct led_sim_view view;
+    LED_SimDecodeMax7219(&view, 4);
+    for (uint8_t d = 0; d < 4; ++d)
+    {
+        CHECK_EQ(view.seg[d], digits1234[d]);
+    }
+
+    // The refresh sends nothing: the controller multiplexes by itself
+    unsigned long count = busCount();
+    runPolled(led, &SevSeg::refreshDigits, 100);
+    CHECK_EQ(busCount(), count);
+    // An unchanged commit sends nothing, a new frame the 4 digit registers
+    led.showText("1234");
+    CHECK_EQ(busCount(), count);
+    led.showText("4321");
+    CHECK_EQ(busCount() - count, 4);
+    LED_SimDecodeMax7219(&view, 4);
+    CHECK_EQ(view.seg[0], LED_4);
+    CHECK_EQ(view.seg[3], LED_1);
+
+    // Brightness maps to the intensity register (0 = shutdown)
+    led.setBrightness(LED_BRIGHT_MAX);
+    count = busCount();
+    unsigned long n;
+    const struct led_host_packet* bus = LED_HostBus(&n);
+    CHECK_EQ(bus[count - 2].data[0], MAX7219_INTENSITY);
+    CHECK_EQ(bus[count - 2].data[1], 15);
+    led.setBrightness(0);
+    CHECK_EQ(busLast()->data[0], MAX7219_SHUTDOWN);
+    CHECK_EQ(busLast()->data[1], 0);
+    LED_SimDecodeMax7219(&view, 4);
+    CHECK_EQ(view.seg[0], SEG_NONE);
+}
+
+static void checkTm1637(void)
+{
+    LED_HostReset();
+    LEDTm1637 out(2, 3);
+    SevSeg led;
+    led.begin(&out, 4);
+    led.showHex(0xBEEF);
+    struct led_sim_view view;
+    LED_SimDecodeTm1637(&view, 4);
+    CHECK_EQ(view.seg[0], LED_b);
+    CHECK_EQ(view.seg[1], LED_E);
+    CHECK_EQ(view.seg[2], LED_E);
+    CHECK_EQ(view.seg[3], LED_F);
+
+    // Data command, address + digits, display control
+    const unsigned long count = busCount();
+    led.showHex(0x1234);
+    CHECK_EQ(busCount() - count, 3);
+    led.setBrightness(0);
+    LED_SimDecodeTm1637(&view, 4);
+    CHECK_EQ(view.seg[0], SEG_NONE);
+}
+
+int main()
+{
+    check595(COMMON_ANODE, false);
+    check595(COMMON_ANODE, true);
+    check595(COMMON_CATHODE, false);
+    check595(COMMON_CATHODE, true);
+    checkMax7219();
+    checkTm1637();
+    return checkDone("checkDrivers");
+}
@@ -0,0 +1,88 @@
+///
+/// Host check: port images under the timer.  A committed page gets the
+/// images of the mode the timer scans it in before it is shown, so the
+/// interrupt never renders images (SCAN_AUTO included).
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "hostCheck.h"
+
+static const byte ledPins[] = { 5, 9, A2, A4, A5, 6, A1, A3, 4, 7, 8, A0 };
+
+// Access the displayed page
+class ImageSeg : public SevSeg
+{
+public:
+    ///
+    /// Test whether the displayed page has images for the mode scanned
+    ///
+    boolean imagesReady()
+    {
+        const struct led_page* page = &m_page[m_front];
+        const uint8_t mode = (m_timerMode == SCAN_AUTO) ? m_scanMode : m_timerMode;
+        return imagesOf(page)->mode == mode;
+    }
+
+    ///
+    /// Test whether a committed page waiting for the next frame has images
+    /// for the mode it will be scanned in
+    ///
+    boolean flipReady()
+    {
+        const struct led_page* page = &m_page[m_front ^ 1];
+        const uint8_t mode = (m_timerMode == SCAN_AUTO) ? page->scanMode : m_timerMode;
+        return !m_flip || imagesOf(page)->mode == mode;
+    }
+};
+
+///
+/// Run the timer tick by tick, checking the images before every slot
+///
+static void runTicks(ImageSeg& led, unsigned ticks)
+{
+    for (unsigned i = 0; i < ticks; ++i)
+    {
+        CHECK(led.imagesReady());
+        LED_HostYield();
+    }
+}
+
+static void checkMode(enum led_scan mode)
+{
+    static const char* const texts[] = { "8888", "1   ", "-AbC", "   7", "8.8.8.8." };
+
+    LED_HostReset();
+    ImageSeg led;
+    led.begin(COMMON_CATHODE, 4, ledPins);
+    // Images of the other scan mode on both pages
+    led.showText("1234");
+    runPolled<SevSeg>(led, (mode == SCAN_DIGITS) ? &SevSeg::refreshSegments : &SevSeg::refreshDigits, 10);
+    led.showText("4321");
+    runPolled<SevSeg>(led, (mode == SCAN_DIGITS) ? &SevSeg::refreshSegments : &SevSeg::refreshDigits, 10);
+
+    CHECK(led.attachTimer(mode, 1000));
+    for (uint8_t t = 0; t < sizeof(texts) / sizeof(texts[0]); ++t)
+    {
+        led.showText(texts[t]);
+        CHECK(led.flipReady());
+        runTicks(led, 40);
+    }
+    led.detachTimer();
+}
+
+int main()
+{
+    checkMode(SCAN_DIGITS);
+    checkMode(SCAN_SEGMENTS);
+    checkMode(SCAN_AUTO);
+    return checkDone("checkImages");
+}
@@ -0,0 +1,106 @@
+///
+/// Host check: key scan on the digit lines (built with LED_KEYS=1).
+/// Presses and releases are debounced and queued with their key number,
+/// the display keeps its content, and a key slot that falls due while
+/// the keypad is being turned off does not hang the refresh.
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "hostCheck.h"
+
+static const byte ledPins[] = { 5, 9, A2, A4, A5, 6, A1, A3, 4, 7, 8, A0 };
+static const byte keyPins[] = { 2, 3 };
+static const enum led_dig keyLines = (enum led_dig)(DIG_0 | DIG_1 | DIG_2 | DIG_3);
+
+// Access the key scan state
+class KeySeg : public SevSeg
+{
+public:
+    /// Test whether a key slot is due
+    boolean keySlotDue()
+    {
+        return m_keyPhase == KEY_DRIVE;
+    }
+
+    /// The point in setKeypad() where the interrupt may find the lines
+    /// cleared with a key slot still due
+    void clearLines()
+    {
+        m_keyLines = DIG_NONE;
+    }
+};
+
+static void checkPolled(void)
+{
+    LED_HostReset();
+    KeySeg led;
+    led.begin(COMMON_CATHODE, 4, ledPins);
+    led.setKeypad(keyPins, 2, keyLines);
+    led.showText("1234");
+    runPolled<SevSeg>(led, &SevSeg::refreshDigits, 50);
+    CHECK_EQ(led.readKey(), KEY_NONE);
+
+    // Digit 2 line to D2: key 1.  Digit 1 line to D3: key MAX_DIGITS.
+    LED_HostKey(ledPins[SEGMENTS + 1], keyPins[0], true);
+    runPolled<SevSeg>(led, &SevSeg::refreshDigits, 100);
+    CHECK(led.keyDown(1));
+    CHECK_EQ(led.readKey(), 1);
+    CHECK_EQ(led.readKey(), KEY_NONE);
+    LED_HostKey(ledPins[SEGMENTS + 1], keyPins[0], false);
+    runPolled<SevSeg>(led, &SevSeg::refreshDigits, 100);
+    CHECK_EQ(led.readKey(), 1 | KEY_UP);
+    LED_HostKey(ledPins[SEGMENTS + 0], keyPins[1], true);
+    runPolled<SevSeg>(led, &SevSeg::refreshDigits, 100);
+    CHECK_EQ(led.readKey(), MAX_DIGITS);
+    CHECK_EQ(led.readKey(), KEY_NONE);
+
+    // The display still shows its content
+    struct led_sim_view view;
+    LED_SimView(&view, COMMON_CATHODE, 4, ledPins, micros() - 50000, micros());
+    CHECK_EQ(view.seg[0], LED_1);
+    CHECK_EQ(view.seg[3], LED_4);
+}
+
+static void checkTimer(void)
+{
+    LED_HostReset();
+    KeySeg led;
+    led.begin(COMMON_CATHODE, 4, ledPins);
+    led.showText("1234");
+    CHECK(led.attachTimer(SCAN_DIGITS, 1000));
+    led.setKeypad(keyPins, 2, keyLines);
+    LED_HostKey(ledPins[SEGMENTS + 3], keyPins[0], true);
+    LED_HostAdvance(100000);
+    CHECK_EQ(led.readKey(), 3);
+
+    // Lines cleared while a key slot is due: the slot is dropped
+    unsigned i;
+    for (i = 0; i < 100 && !led.keySlotDue(); ++i)
+        LED_HostAdvance(1000);
+    CHECK(led.keySlotDue());
+    led.clearLines();
+    LED_HostAdvance(10000);
+    CHECK(!led.keySlotDue());
+
+    // Turning the keypad off stops the key slots
+    led.setKeypad(keyPins, 0, DIG_NONE);
+    LED_HostAdvance(100000);
+    CHECK(!led.keySlotDue());
+    led.detachTimer();
+}
+
+int main()
+{
+    checkPolled();
+    checkTimer();
+    return checkDone("checkKeys");
+}
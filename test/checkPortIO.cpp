@@ -0,0 +1,70 @@
+///
+/// Host check: direct port output (LED_PORT_IO).  The Makefile builds this
+/// program with LED_PORT_IO=0 (digitalWrite) and LED_PORT_IO=1 (masked
+/// port writes) and compares the register states both builds print after
+/// every refresh: the two output paths must drive the pins identically.
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "hostCheck.h"
+
+static const byte ledPins[] = { 5, 9, A2, A4, A5, 6, A1, A3, 4, 7, 8, A0 };
+
+///
+/// Print the output registers
+///
+static void printPorts(void)
+{
+    printf("%lu %02X %02X %02X\n", micros(),
+           (unsigned) PORTB, (unsigned) PORTC, (unsigned) PORTD);
+}
+
+///
+/// Run a polled refresh through changing text and brightness, printing the
+/// pin state after every slot
+///
+static void runScan(enum led_config conf, boolean segments)
+{
+    static const char* const texts[] = { "1234", "8.8.8.8.", "-AbC", " 7 ." };
+
+    LED_HostReset();
+    SevSeg led;
+    led.begin(conf, 4, ledPins);
+    printPorts();
+    for (uint8_t t = 0; t < sizeof(texts) / sizeof(texts[0]); ++t)
+    {
+        led.showText(texts[t]);
+        led.setBrightness(t & 1 ? LED_BRIGHT_MAX / 2 : LED_BRIGHT_MAX);
+        for (uint8_t i = 0; i < 40; ++i)
+        {
+            LED_HostAdvance(1000);
+            if (segments)
+                led.refreshSegments();
+            else
+                led.refreshDigits();
+            printPorts();
+        }
+    }
+    led.setSkipEmpty(true);
+    led.showText("    ");
+    led.refreshDigits();
+    printPorts();
+}
+
+int main()
+{
+    runScan(COMMON_CATHODE, false);
+    runScan(COMMON_CATHODE, true);
+    runScan(COMMON_ANODE, false);
+    runScan(COMMON_ANODE, true);
+    return 0;
+}
@@ -0,0 +1,115 @@
+///
+/// Host check: power save.  The timer interrupt only records the state
+/// change and turns the pins off; the timer rate and a controller's blank
+/// frame change outside the interrupt (update(), idle() or a commit).
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "hostCheck.h"
+#include "LEDDrivers.h"
+
+static const byte ledPins[] = { 5, 9, A2, A4, A5, 6, A1, A3, 4, 7, 8, A0 };
+
+typedef SevSegT<COMMON_CATHODE, 4, 5, 9, A2, A4, A5, 6, A1, A3, 4, 7, 8, A0> LedT;
+
+///
+/// Timer ticks during the next second
+///
+static unsigned long ticksPerSecond(void)
+{
+    const unsigned long ticks = LED_HostTicks();
+    LED_HostAdvance(1000000);
+    return LED_HostTicks() - ticks;
+}
+
+///
+/// Test whether every digit pin is off (common cathode: high)
+///
+static boolean digitsOff(void)
+{
+    for (uint8_t d = 0; d < 4; ++d)
+    {
+        if (digitalRead(ledPins[SEGMENTS + d]) != HIGH)
+            return false;
+    }
+    return true;
+}
+
+template <class Display> static void checkPins(Display& led)
+{
+    led.showText("8888");
+    CHECK(led.attachTimer(SCAN_DIGITS, 1000));
+    led.setPowerSave(1, 3, 250);
+
+    // Low rate: state changed in the interrupt, rate changed by update()
+    LED_HostAdvance(1500000);
+    CHECK_EQ(led.powerState(), POWER_LOW);
+    CHECK_EQ(ticksPerSecond(), 1000);
+    led.update();
+    CHECK_EQ(ticksPerSecond(), 250);
+
+    // Blank: pins off from the interrupt, timer stopped by idle()
+    LED_HostAdvance(1000000);
+    CHECK_EQ(led.powerState(), POWER_BLANK);
+    CHECK(digitsOff());
+    SevSeg::idle();
+    CHECK_EQ(ticksPerSecond(), 0);
+    CHECK(digitsOff());
+
+    // A commit restores the display and the full rate at once
+    led.showText("1234");
+    CHECK_EQ(led.powerState(), POWER_ON);
+    CHECK_EQ(ticksPerSecond(), 1000);
+    CHECK(!digitsOff());
+    led.detachTimer();
+}
+
+int main()
+{
+    {
+        LED_HostReset();
+        SevSeg led;
+        led.begin(COMMON_CATHODE, 4, ledPins);
+        checkPins(led);
+    }
+    {
+        LED_HostReset();
+        LedT led;
+        led.begin();
+        checkPins(led);
+    }
+
+    // A controller gets its blank frame outside the interrupt
+    LED_HostReset();
+    LEDMax7219 out(10);
+    SevSeg led;
+    led.begin(&out, 4);
+    led.showText("1234");
+    CHECK(led.attachTimer(SCAN_DIGITS, 1000));
+    led.setPowerSave(0, 1, 250);
+    unsigned long count;
+    LED_HostBus(&count);
+    LED_HostAdvance(1500000);
+    CHECK_EQ(led.powerState(), POWER_BLANK);
+    unsigned long after;
+    LED_HostBus(&after);
+    CHECK_EQ(after, count);
+    led.update();
+    struct led_sim_view view;
+    LED_SimDecodeMax7219(&view, 4);
+    CHECK_EQ(view.seg[0], SEG_NONE);
+    led.showText("4321");
+    LED_SimDecodeMax7219(&view, 4);
+    CHECK_EQ(view.seg[0], LED_4);
+    led.detachTimer();
+    return checkDone("checkPower");
+}
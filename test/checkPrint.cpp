@@ -0,0 +1,144 @@
+///
+/// Host check: LEDPrint.  print(double) and println(double) show the same
+/// digits as formatting with snprintf() and printing the text, drop
+/// decimals that do not fit, and show "----" or "E" otherwise.  Prints
+/// the time per call of both ways (host only; see examples/benchPrint for
+/// AVR cycles).
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "hostCheck.h"
+#include "LEDPrint.h"
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+// Access the display page to compare results
+class PrintSeg : public SevSeg
+{
+public:
+    const enum led_seg* front() { return m_page[m_front].buf; }
+};
+
+static const byte ledPins[] = { 5, 9, A2, A4, A5, 6, A1, A3, 4, 7, 8, A0 };
+
+static PrintSeg s_led;
+static LEDPrint s_lcd(s_led);
+static enum led_seg s_ref[MAX_DIGITS];
+
+///
+/// Save the digits shown as reference
+///
+static void saveRef(void)
+{
+    for (uint8_t d = 0; d < 4; ++d)
+        s_ref[d] = s_led.front()[d];
+}
+
+///
+/// Test whether the display shows the reference digits
+///
+static boolean sameAsRef(void)
+{
+    for (uint8_t d = 0; d < 4; ++d)
+    {
+        if (s_ref[d] != s_led.front()[d])
+            return false;
+    }
+    return true;
+}
+
+///
+/// Nanoseconds of CPU time since start
+///
+static double elapsed(clock_t start, unsigned long calls)
+{
+    return (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / calls;
+}
+
+int main()
+{
+    char text[32];
+    s_led.begin(COMMON_CATHODE, 4, ledPins);
+
+    // Same digits as snprintf() over -9.99..9.99 (no .5 ties).  LEDPrint
+    // shows no sign when the value rounds to zero.
+    for (int i = -963; i <= 963; ++i)
+    {
+        const double value = i * 0.01037;
+        for (int dp = 0; dp <= 2; ++dp)
+        {
+            snprintf(text, sizeof(text), "%.*f", dp, value);
+            if (text[0] == '-' && strspn(text, "-0.") == strlen(text))
+                continue;
+            s_lcd.println(text);
+            saveRef();
+            s_lcd.println(value, dp);
+            CHECK(sameAsRef());
+            s_lcd.print(value, dp);
+            s_lcd.println();
+            CHECK(sameAsRef());
+        }
+    }
+
+    // Decimals dropped to fit, then "----"; NaN and infinity "E"
+    s_lcd.println("12.35");
+    saveRef();
+    s_lcd.println(12.3456, 3);
+    CHECK(sameAsRef());
+    s_lcd.println("----");
+    saveRef();
+    s_lcd.println(12345.6, 1);
+    CHECK(sameAsRef());
+    s_lcd.println(-1234.0, 0);
+    CHECK(sameAsRef());
+    s_lcd.println("E");
+    saveRef();
+    s_lcd.println(NAN, 2);
+    CHECK(sameAsRef());
+    s_lcd.println(-INFINITY, 2);
+    CHECK(sameAsRef());
+
+    // A dropped character does not leave its '.' to the last digit shown
+    s_lcd.println("1234");
+    saveRef();
+    s_lcd.println("12345.6");
+    CHECK(sameAsRef());
+    s_lcd.println("1.234");
+    saveRef();
+    s_lcd.println("1.2345.6");
+    CHECK(sameAsRef());
+
+    // println(double) ends the line: the next print starts a new one
+    s_lcd.println("7");
+    saveRef();
+    s_lcd.println(1.5, 1);
+    s_lcd.print(7);
+    s_lcd.println();
+    CHECK(sameAsRef());
+
+    // Time per call: fixed point vs snprintf() and printing the text
+    const unsigned long calls = 200000;
+    clock_t start = clock();
+    for (unsigned long i = 0; i < calls; ++i)
+        s_lcd.println((double)(i % 2000) * 0.01037 - 10, 2);
+    const double fixed = elapsed(start, calls);
+    start = clock();
+    for (unsigned long i = 0; i < calls; ++i)
+    {
+        snprintf(text, sizeof(text), "%.*f", 2, (double)(i % 2000) * 0.01037 - 10);
+        s_lcd.println(text);
+    }
+    const double formatted = elapsed(start, calls);
+    printf("checkPrint: println(double) %.0f ns, snprintf + println %.0f ns (host)\n", fixed, formatted);
+    return checkDone("checkPrint");
+}
@@ -0,0 +1,119 @@
+///
+/// Host check: delta-only pin updates and dirty digits.  Each scan slot
+/// toggles only the lines whose level changes, a commit without changes
+/// does nothing, setDigit() touches one digit, and detachTimer() turns the
+/// digits off for SevSeg and SevSegT alike.
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "hostCheck.h"
+#include "LEDDrivers.h"
+
+static const byte ledPins[] = { 5, 9, A2, A4, A5, 6, A1, A3, 4, 7, 8, A0 };
+
+typedef SevSegT<COMMON_CATHODE, 4, 5, 9, A2, A4, A5, 6, A1, A3, 4, 7, 8, A0> LedT;
+
+///
+/// Count the lines that differ between two register states
+///
+static unsigned long lineDiff(const uint8_t* a, const uint8_t* b)
+{
+    unsigned long bits = 0;
+    for (uint8_t p = 0; p < HOST_PORTS; ++p)
+    {
+        for (uint8_t diff = (uint8_t)(a[p] ^ b[p]); diff; diff >>= 1)
+            bits += diff & 1;
+    }
+    return bits;
+}
+
+///
+/// Run a polled refresh and check that the pins toggled are exactly the
+/// lines that differ between consecutive slots
+///
+template <class Display> static void checkMinimal(Display& led, void (Display::*refresh)(void))
+{
+    led.showText("1.2.3.4");
+    runPolled(led, refresh, 10);
+    const unsigned long from = micros() + 1;
+    uint8_t last[HOST_PORTS] = { PORTB, PORTC, PORTD };
+    unsigned long minimal = 0;
+    for (uint8_t i = 0; i < 100; ++i)
+    {
+        runPolled(led, refresh, 1);
+        const uint8_t now[HOST_PORTS] = { PORTB, PORTC, PORTD };
+        minimal += lineDiff(last, now);
+        for (uint8_t p = 0; p < HOST_PORTS; ++p)
+            last[p] = now[p];
+    }
+    CHECK(minimal > 0);
+    CHECK_EQ(LED_HostTransitions(from, micros() + 1), minimal);
+}
+
+///
+/// Run from the timer, detach and check that every digit is off
+///
+template <class Display> static void checkDetach(Display& led)
+{
+    led.showText("8888");
+    CHECK(led.attachTimer(SCAN_SEGMENTS, 1000));
+    LED_HostAdvance(10500);
+    led.detachTimer();
+    for (uint8_t d = 0; d < 4; ++d)
+    {
+        // Common cathode: a digit is off when its pin is high
+        CHECK_EQ(digitalRead(ledPins[SEGMENTS + d]), HIGH);
+    }
+}
+
+int main()
+{
+    {
+        LED_HostReset();
+        SevSeg led;
+        led.begin(COMMON_CATHODE, 4, ledPins);
+        checkMinimal(led, &SevSeg::refreshSegments);
+        checkMinimal(led, &SevSeg::refreshDigits);
+        checkDetach(led);
+    }
+    {
+        LED_HostReset();
+        LedT led;
+        led.begin();
+        checkMinimal(led, &LedT::refreshSegments);
+        checkMinimal(led, &LedT::refreshDigits);
+        checkDetach(led);
+    }
+
+    // A commit without changes sends nothing; setDigit() changes one digit
+    LED_HostReset();
+    LEDMax7219 out(10);
+    SevSeg led;
+    led.begin(&out, 4);
+    led.showText("1234");
+    unsigned long count;
+    LED_HostBus(&count);
+    led.setAutoCommit(false);
+    led.commit();
+    unsigned long after;
+    LED_HostBus(&after);
+    CHECK_EQ(after, count);
+    led.setDigit(2, LED_7);
+    led.commit();
+    LED_HostBus(&after);
+    CHECK(after > count);
+    struct led_sim_view view;
+    LED_SimDecodeMax7219(&view, 4);
+    CHECK_EQ(view.seg[1], LED_2);
+    CHECK_EQ(view.seg[2], LED_7);
+    return checkDone("checkShadow");
+}
@@ -0,0 +1,117 @@
+///
+/// Host check: register trace and display simulator (LEDHost, LEDSim).
+/// The trace must record every register change in time order, and the
+/// simulator must see the committed digits for both scan directions and
+/// both polarities.
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "hostCheck.h"
+
+static const byte ledPins[] = { 5, 9, A2, A4, A5, 6, A1, A3, 4, 7, 8, A0 };
+static const enum led_seg digits1234[4] = { LED_1, LED_2, LED_3, LED_4 };
+
+///
+/// Count the bits that changed between the register values of a trace,
+/// the way LED_HostTransitions() should
+///
+static unsigned long countTrace(unsigned long from, unsigned long to)
+{
+    unsigned long count;
+    const struct led_host_event* trace = LED_HostTrace(&count);
+    uint8_t state[HOST_PORTS] = { 0, 0, 0 };
+    unsigned long bits = 0;
+    for (unsigned long i = 0; i < count; ++i)
+    {
+        if (trace[i].usec >= from && trace[i].usec < to)
+        {
+            for (uint8_t diff = (uint8_t)(state[trace[i].port] ^ trace[i].value); diff; diff >>= 1)
+                bits += diff & 1;
+        }
+        state[trace[i].port] = trace[i].value;
+    }
+    return bits;
+}
+
+///
+/// Show 1234 with one polarity and scan direction and check the
+/// perceived display
+///
+static void checkScan(enum led_config conf, boolean segments)
+{
+    LED_HostReset();
+    SevSeg led;
+    led.begin(conf, 4, ledPins);
+    led.showText("1234");
+    runPolled(led, segments ? &SevSeg::refreshSegments : &SevSeg::refreshDigits, 200);
+
+    struct led_sim_view view;
+    LED_SimView(&view, conf, 4, ledPins, 100000, 200000);
+    for (uint8_t d = 0; d < 4; ++d)
+    {
+        CHECK_EQ(view.seg[d], digits1234[d]);
+        if (!segments)
+        {
+            // One digit per slot: each digit is lit a quarter of the time
+            CHECK(view.digitOn[d] >= 24000 && view.digitOn[d] <= 26000);
+        }
+    }
+
+    // The trace is in time order and matches LED_HostTransitions()
+    unsigned long count;
+    const struct led_host_event* trace = LED_HostTrace(&count);
+    CHECK(count > 0);
+    for (unsigned long i = 1; i < count; ++i)
+    {
+        CHECK(trace[i - 1].usec <= trace[i].usec);
+    }
+    CHECK(LED_HostTransitions(100000, 200000) > 0);
+    CHECK_EQ(LED_HostTransitions(100000, 200000), countTrace(100000, 200000));
+}
+
+int main()
+{
+    checkScan(COMMON_CATHODE, false);
+    checkScan(COMMON_CATHODE, true);
+    checkScan(COMMON_ANODE, false);
+    checkScan(COMMON_ANODE, true);
+
+    // begin() turns every digit off
+    LED_HostReset();
+    SevSeg led;
+    led.begin(COMMON_CATHODE, 4, ledPins);
+    for (uint8_t d = 0; d < 4; ++d)
+    {
+        CHECK_EQ(digitalRead(ledPins[SEGMENTS + d]), HIGH);
+    }
+
+    // The simulated timer refreshes at the attached rate
+    led.showText("8888");
+    if (led.attachTimer(SCAN_DIGITS, 1000))
+    {
+        const unsigned long ticks = LED_HostTicks();
+        LED_HostAdvance(1000000);
+        CHECK_EQ(LED_HostTicks() - ticks, 1000);
+        struct led_sim_view view;
+        LED_SimView(&view, COMMON_CATHODE, 4, ledPins, micros() - 100000, micros());
+        for (uint8_t d = 0; d < 4; ++d)
+        {
+            CHECK_EQ(view.seg[d], LED_8);
+        }
+        led.detachTimer();
+    }
+    else
+    {
+        CHECK(!"attachTimer(SCAN_DIGITS, 1000) failed");
+    }
+    return checkDone("checkTrace");
+}
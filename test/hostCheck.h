@@ -0,0 +1,84 @@
+#ifndef HOST_CHECK_H_FILE
+#define HOST_CHECK_H_FILE
+///
+/// @file hostCheck.h
+///
+/// Assertions shared by the host checks (see Makefile).  A check prints
+/// each failed assertion and returns non-zero from main() through
+/// checkDone().
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+/// http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+#include "LED7Seg.h"
+#include "LEDSim.h"
+#include <stdio.h>
+
+static unsigned s_checks;           // Assertions evaluated
+static unsigned s_failures;         // Assertions failed
+
+/// Fail if cond is false
+#define CHECK(cond) \
+    checkTrue((cond), #cond, __FILE__, __LINE__)
+
+/// Fail unless a == b (both printed as unsigned long)
+#define CHECK_EQ(a, b) \
+    checkEqual((unsigned long)(a), (unsigned long)(b), #a, #b, __FILE__, __LINE__)
+
+static inline void checkTrue(bool ok, const char* expr, const char* file, int line)
+{
+    ++s_checks;
+    if (!ok)
+    {
+        ++s_failures;
+        printf("%s:%d: CHECK(%s) failed\n", file, line, expr);
+    }
+}
+
+static inline void checkEqual(unsigned long a, unsigned long b, const char* exprA, const char* exprB,
+                       const char* file, int line)
+{
+    ++s_checks;
+    if (a != b)
+    {
+        ++s_failures;
+        printf("%s:%d: CHECK_EQ(%s, %s) failed: %lu != %lu\n", file, line, exprA, exprB, a, b);
+    }
+}
+
+///
+/// Report the result of a check program
+/// @param  name    Check name
+/// @return status  0 if all assertions passed (exit code for main())
+///
+static inline int checkDone(const char* name)
+{
+    printf("%s: %u checks, %u failed\n", name, s_checks, s_failures);
+    return s_failures ? 1 : 0;
+}
+
+///
+/// Advance virtual time one millisecond at a time, calling a polled
+/// refresh method after each step
+/// @param  led     Display
+/// @param  refresh &SevSeg::refreshDigits or &SevSeg::refreshSegments
+/// @param  msec    Milliseconds to run
+///
+template <class Display> static void runPolled(Display& led, void (Display::*refresh)(void), unsigned long msec)
+{
+    for (unsigned long i = 0; i < msec; ++i)
+    {
+        LED_HostAdvance(1000);
+        (led.*refresh)();
+    }
+}
+
+#endif